@@ -0,0 +1,68 @@
+#include "arena.h"
+#include <stdlib.h>
+#include <string.h>
+
+struct ArenaBlock {
+  ArenaBlock *next;
+  size_t size; // Usable bytes after the header
+  size_t top;  // Next free offset
+  max_align_t data[];
+};
+
+#define ARENA_ALIGN sizeof(max_align_t)
+
+void arena_init(Arena *a, size_t block_size) {
+  a->head = NULL;
+  a->block_size = block_size ? block_size : ARENA_DEFAULT_BLOCK;
+  a->used = 0;
+}
+
+void *arena_alloc(Arena *a, size_t size) {
+  size = (size + ARENA_ALIGN - 1) & ~(ARENA_ALIGN - 1);
+  ArenaBlock *b = a->head;
+  if (!b || b->size - b->top < size) {
+    // Each block at least doubles the previous one: O(log n) blocks
+    size_t cap = a->block_size ? a->block_size : ARENA_DEFAULT_BLOCK;
+    if (a->head && cap < 2 * a->head->size)
+      cap = 2 * a->head->size;
+    if (cap < size)
+      cap = size;
+    b = malloc(sizeof(ArenaBlock) + cap);
+    if (!b)
+      return NULL;
+    b->size = cap;
+    b->top = 0;
+    b->next = a->head;
+    a->head = b;
+  }
+  void *p = (char *)b->data + b->top;
+  b->top += size;
+  a->used += size;
+  return p;
+}
+
+char *arena_strdup(Arena *a, const char *s) {
+  size_t len = strlen(s) + 1;
+  char *p = arena_alloc(a, len);
+  return p ? memcpy(p, s, len) : NULL;
+}
+
+void arena_reset(Arena *a) {
+  if (!a->head)
+    return;
+  ArenaBlock *b = a->head->next;
+  while (b) {
+    ArenaBlock *next = b->next;
+    free(b);
+    b = next;
+  }
+  a->head->next = NULL;
+  a->head->top = 0;
+  a->used = 0;
+}
+
+void arena_free(Arena *a) {
+  arena_reset(a);
+  free(a->head);
+  a->head = NULL;
+}
@@ -0,0 +1,33 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// Bump allocator owning every element of a dataset: one malloc per block
+// instead of one per element, and everything is released at once.
+// No GTK dependency.
+
+typedef struct ArenaBlock ArenaBlock;
+
+typedef struct {
+  ArenaBlock *head;  // Block being filled; older blocks follow
+  size_t block_size; // Minimum size of the next block
+  size_t used;       // Bytes handed out since the last reset
+} Arena;
+
+// block_size 0 picks ARENA_DEFAULT_BLOCK; a zeroed Arena is ready to use.
+// Nothing is allocated until the first arena_alloc.
+#define ARENA_DEFAULT_BLOCK (1 << 20)
+void arena_init(Arena *a, size_t block_size);
+
+// Aligned for any type. When the current block is full the next one is at
+// least twice as large. Returns NULL when malloc fails.
+void *arena_alloc(Arena *a, size_t size);
+char *arena_strdup(Arena *a, const char *s);
+
+// Keeps the newest block for reuse and frees the others: after a reset the
+// arena refills without calling malloc again.
+void arena_reset(Arena *a);
+void arena_free(Arena *a);
+
+#endif
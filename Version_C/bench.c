@@ -0,0 +1,383 @@
+#include "bench.h"
+#include "parallel_sort.h"
+#include "rng.h"
+#include "sort.h"
+#include "typed_sort.h"
+#include <limits.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+static const char *dist_ids[DIST_COUNT] = {
+    "uniform", "sorted", "reversed", "nearly",
+    "organpipe", "fewunique", "zipf", "equal"};
+static const char *dist_names[DIST_COUNT] = {
+    "Aleatoire", "Trie",           "Inverse", "Presque trie",
+    "Orgue",     "Peu de valeurs", "Zipf",    "Tous egaux"};
+
+const char *bench_dist_id(BenchDist dist) { return dist_ids[dist]; }
+
+const char *bench_dist_name(BenchDist dist) { return dist_names[dist]; }
+
+int bench_dist_find(const char *id) {
+  for (int d = 0; d < DIST_COUNT; d++)
+    if (strcmp(dist_ids[d], id) == 0)
+      return d;
+  return -1;
+}
+
+// --- Option Lists ---
+
+static int list_full(int count, int max) {
+  if (count < max)
+    return 0;
+  fprintf(stderr, "Liste trop longue (max %d valeurs)\n", max);
+  return 1;
+}
+
+int bench_parse_ids(char *arg, int (*lookup)(const char *), int *out,
+                    int max) {
+  int count = 0;
+  for (char *tok = strtok(arg, ","); tok; tok = strtok(NULL, ",")) {
+    if (list_full(count, max))
+      return -1;
+    int v = lookup(tok);
+    if (v < 0) {
+      fprintf(stderr, "Inconnu: %s\n", tok);
+      return -1;
+    }
+    out[count++] = v;
+  }
+  return count;
+}
+
+int bench_parse_sizes(char *arg, int *out, int max) {
+  int count = 0;
+  for (char *tok = strtok(arg, ","); tok; tok = strtok(NULL, ",")) {
+    if (list_full(count, max))
+      return -1;
+    char *end;
+    long n = strtol(tok, &end, 10);
+    if (*end || n <= 0 || n > INT_MAX) {
+      fprintf(stderr, "Taille invalide: %s\n", tok);
+      return -1;
+    }
+    out[count++] = (int)n;
+  }
+  return count;
+}
+
+int bench_parse_fractions(char *arg, double *out, int max) {
+  int count = 0;
+  for (char *tok = strtok(arg, ","); tok; tok = strtok(NULL, ",")) {
+    if (list_full(count, max))
+      return -1;
+    char *end;
+    double f = strtod(tok, &end);
+    if (*end || !(f >= 0 && f <= 1)) { // NaN fails both tests
+      fprintf(stderr, "Fraction invalide: %s\n", tok);
+      return -1;
+    }
+    out[count++] = f;
+  }
+  return count;
+}
+
+static void reverse_int(int *arr, int n) {
+  for (int k = 0; k < n / 2; k++) {
+    int t = arr[k];
+    arr[k] = arr[n - 1 - k];
+    arr[n - 1 - k] = t;
+  }
+}
+
+// --- Generation ---
+// Random values come from rng_fill_parallel: chunk streams of the seed, so
+// large inputs are drawn on every core and stay the same for a given seed
+
+typedef struct {
+  int range;
+  int step;          // DIST_FEW_UNIQUE: distance between the values
+  const double *cdf; // DIST_ZIPF: cumulative weights of [0, range)
+  double sum;
+} FillParams;
+
+static void fill_uniform(int *arr, int n, Rng *rng, void *ctx) {
+  const FillParams *p = ctx;
+  for (int k = 0; k < n; k++)
+    arr[k] = (int)rng_below(rng, p->range);
+}
+
+static void fill_few_unique(int *arr, int n, Rng *rng, void *ctx) {
+  const FillParams *p = ctx;
+  for (int k = 0; k < n; k++)
+    arr[k] = (int)rng_below(rng, BENCH_FEW_UNIQUE) * p->step % p->range;
+}
+
+// Zipf (s = 1) over [0, range): inverse CDF by binary search
+static void fill_zipf(int *arr, int n, Rng *rng, void *ctx) {
+  const FillParams *p = ctx;
+  for (int k = 0; k < n; k++) {
+    double u = rng_double(rng) * p->sum;
+    int lo = 0, hi = p->range - 1;
+    while (lo < hi) {
+      int mid = lo + (hi - lo) / 2;
+      if (p->cdf[mid] <= u)
+        lo = mid + 1;
+      else
+        hi = mid;
+    }
+    arr[k] = lo;
+  }
+}
+
+// Ascending order of values in [0, range): counting when the range is not
+// larger than the input, the parallel sort otherwise
+static void sort_values(int *arr, int n, int range, int threads) {
+  if (range > n) {
+    parallel_sort_int(arr, n, 0, threads);
+    return;
+  }
+  int *count = calloc(range, sizeof(int));
+  for (int k = 0; k < n; k++)
+    count[arr[k]]++;
+  for (int v = 0, k = 0; v < range; v++)
+    for (int c = count[v]; c > 0; c--)
+      arr[k++] = v;
+  free(count);
+}
+
+void bench_generate(int *arr, int n, BenchDist dist, unsigned int seed,
+                    int range, int swaps) {
+  FillParams p = {range < 1 ? 1 : range, 1, NULL, 0.0};
+  int threads = parallel_default_threads();
+
+  switch (dist) {
+  case DIST_EQUAL:
+    for (int k = 0; k < n; k++)
+      arr[k] = p.range / 2;
+    return;
+  case DIST_FEW_UNIQUE:
+    if (p.range / BENCH_FEW_UNIQUE > 0)
+      p.step = p.range / BENCH_FEW_UNIQUE;
+    rng_fill_parallel(arr, n, seed, threads, fill_few_unique, &p);
+    return;
+  case DIST_ZIPF: {
+    double *cdf = malloc(p.range * sizeof(double));
+    for (int r = 0; r < p.range; r++)
+      cdf[r] = p.sum += 1.0 / (r + 1);
+    p.cdf = cdf;
+    rng_fill_parallel(arr, n, seed, threads, fill_zipf, &p);
+    free(cdf);
+    return;
+  }
+  default:
+    break;
+  }
+
+  rng_fill_parallel(arr, n, seed, threads, fill_uniform, &p);
+  if (dist == DIST_UNIFORM)
+    return;
+
+  sort_values(arr, n, p.range, threads);
+  if (dist == DIST_REVERSED) {
+    reverse_int(arr, n);
+  } else if (dist == DIST_ORGAN_PIPE) {
+    // Even ranks climb on the left, odd ranks fall back on the right
+    int *tmp = malloc(n * sizeof(int));
+    int left = 0, right = n - 1;
+    for (int k = 0; k < n; k++)
+      if (k % 2 == 0)
+        tmp[left++] = arr[k];
+      else
+        tmp[right--] = arr[k];
+    memcpy(arr, tmp, n * sizeof(int));
+    free(tmp);
+  } else if (dist == DIST_NEARLY_SORTED && n > 1) {
+    // Swaps draw from the first stream the fill did not use
+    Rng rng;
+    rng_stream(&rng, seed, rng_fill_streams(n));
+    if (swaps < 0)
+      swaps = n / 100 > 0 ? n / 100 : 1;
+    for (int s = 0; s < swaps; s++) {
+      int i = (int)rng_below(&rng, n), j = (int)rng_below(&rng, n);
+      int t = arr[i];
+      arr[i] = arr[j];
+      arr[j] = t;
+    }
+  }
+}
+
+void bench_fill(int *arr, int n, BenchDist dist, unsigned int seed) {
+  bench_generate(arr, n, dist, seed, 1000, -1);
+}
+
+double bench_now_ms(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000.0 + ts.tv_nsec / 1e6;
+}
+
+double bench_time_kernel(int algo, const int *input, int *work, int n) {
+  memcpy(work, input, n * sizeof(int));
+  double start = bench_now_ms();
+  sort_kernels[algo].run(work, n);
+  return bench_now_ms() - start;
+}
+
+double bench_time_parallel(const int *input, int *work, int n, int threads) {
+  memcpy(work, input, n * sizeof(int));
+  double start = bench_now_ms();
+  parallel_sort_int(work, n, 0, threads);
+  return bench_now_ms() - start;
+}
+
+double bench_time_boxed(int algo, const int *input, int n) {
+  if (!sort_is_comparison(algo))
+    return -1.0;
+  void **boxed = malloc(n * sizeof(void *));
+  for (int k = 0; k < n; k++) {
+    int *v = malloc(sizeof(int));
+    *v = input[k];
+    boxed[k] = v;
+  }
+
+  double start = bench_now_ms();
+  boxed_sort(boxed, n, TYPE_INT, algo, 0);
+  double ms = bench_now_ms() - start;
+
+  for (int k = 0; k < n; k++)
+    free(boxed[k]);
+  free(boxed);
+  return ms;
+}
+
+void bench_count_kernel(int algo, const int *input, int *work, int n,
+                        PerfCounters *pc, PerfSample *out) {
+  memcpy(work, input, n * sizeof(int));
+  perf_counters_start(pc);
+  sort_kernels[algo].run(work, n);
+  perf_counters_stop(pc, out);
+}
+
+// --- Repeated Measurements ---
+
+static int cmp_double_asc(const void *a, const void *b) {
+  double x = *(const double *)a, y = *(const double *)b;
+  return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile on sorted samples
+static double percentile(const double *sorted, int count, double p) {
+  int rank = (int)ceil(p * count) - 1;
+  if (rank < 0)
+    rank = 0;
+  return sorted[rank];
+}
+
+void bench_stats(double *samples, int count, BenchStats *st) {
+  st->runs = count;
+  if (count == 0)
+    return;
+  qsort(samples, count, sizeof(double), cmp_double_asc);
+
+  double sum = 0.0;
+  for (int i = 0; i < count; i++)
+    sum += samples[i];
+  st->mean = sum / count;
+  double var = 0.0;
+  for (int i = 0; i < count; i++)
+    var += (samples[i] - st->mean) * (samples[i] - st->mean);
+  st->stddev = count > 1 ? sqrt(var / (count - 1)) : 0.0;
+
+  st->min = samples[0];
+  st->median = count % 2 ? samples[count / 2]
+                         : (samples[count / 2 - 1] + samples[count / 2]) / 2;
+  st->p95 = percentile(samples, count, 0.95);
+}
+
+void bench_measure(int algo, int boxed, const int *input, int *work, int n,
+                   int warmup, int repeats, BenchStats *st) {
+  st->runs = 0;
+  if (boxed && !sort_is_comparison(algo))
+    return;
+
+  for (int i = 0; i < warmup; i++) {
+    if (boxed)
+      bench_time_boxed(algo, input, n);
+    else
+      bench_time_kernel(algo, input, work, n);
+  }
+
+  double *samples = malloc(repeats * sizeof(double));
+  for (int i = 0; i < repeats; i++)
+    samples[i] = boxed ? bench_time_boxed(algo, input, n)
+                       : bench_time_kernel(algo, input, work, n);
+  bench_stats(samples, repeats, st);
+  free(samples);
+}
+
+// --- Size Sweeps ---
+
+int bench_geometric_sizes(int lo_exp, int hi_exp, int per_octave, int *out,
+                          int max) {
+  if (per_octave < 1)
+    per_octave = 1;
+  int count = 0;
+  for (int i = 0; i <= (hi_exp - lo_exp) * per_octave && count < max; i++) {
+    int n = (int)lround(ldexp(1.0, lo_exp) * exp2((double)i / per_octave));
+    if (count == 0 || n > out[count - 1])
+      out[count++] = n;
+  }
+  return count;
+}
+
+int bench_fit(const int *n, const double *t, int count, BenchFit *fit) {
+  // Power law: straight line log t = log a + b log n
+  double sx = 0, sy = 0, sxx = 0, sxy = 0, syy = 0;
+  int k = 0;
+  for (int i = 0; i < count; i++) {
+    if (t[i] <= 0 || n[i] < 2)
+      continue;
+    double x = log(n[i]), y = log(t[i]);
+    sx += x;
+    sy += y;
+    sxx += x * x;
+    sxy += x * y;
+    syy += y * y;
+    k++;
+  }
+  double den = k * sxx - sx * sx;
+  if (k < 2 || den <= 1e-12)
+    return 0;
+  fit->b = (k * sxy - sx * sy) / den;
+  fit->a = exp((sy - fit->b * sx) / k);
+  double ss_tot = syy - sy * sy / k;
+
+  // n log n: only the factor is free, log a = mean(log t - log(n log2 n))
+  double sr = 0;
+  for (int i = 0; i < count; i++)
+    if (t[i] > 0 && n[i] >= 2)
+      sr += log(t[i]) - log(n[i] * log2(n[i]));
+  fit->a_nlogn = exp(sr / k);
+
+  double ss_pow = 0, ss_nlogn = 0;
+  for (int i = 0; i < count; i++) {
+    if (t[i] <= 0 || n[i] < 2)
+      continue;
+    double y = log(t[i]);
+    double e_pow = y - log(fit->a) - fit->b * log(n[i]);
+    double e_nlogn = y - log(fit->a_nlogn * n[i] * log2(n[i]));
+    ss_pow += e_pow * e_pow;
+    ss_nlogn += e_nlogn * e_nlogn;
+  }
+  fit->r2 = ss_tot > 0 ? 1 - ss_pow / ss_tot : 1;
+  fit->r2_nlogn = ss_tot > 0 ? 1 - ss_nlogn / ss_tot : 1;
+  // Residual variance per degree of freedom: k - 2 for the power fit,
+  // k - 1 for n log n, against k - 1 for the total
+  fit->r2_adj = k > 2 ? 1 - (1 - fit->r2) * (k - 1) / (k - 2) : NAN;
+  fit->r2_nlogn_adj = fit->r2_nlogn;
+  return 1;
+}
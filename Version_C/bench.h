@@ -0,0 +1,103 @@
+#ifndef BENCH_H
+#define BENCH_H
+
+// Benchmark input generation and timing, shared by the sorting view and the
+// headless runner in bench/. No GTK dependency.
+
+#include "perf_counters.h"
+
+typedef enum {
+  DIST_UNIFORM,
+  DIST_SORTED,
+  DIST_REVERSED,
+  DIST_NEARLY_SORTED, // Sorted, then k random swaps
+  DIST_ORGAN_PIPE,    // Ascending first half, descending second half
+  DIST_FEW_UNIQUE,    // BENCH_FEW_UNIQUE distinct values
+  DIST_ZIPF,          // P(value = r) proportional to 1 / (r + 1)
+  DIST_EQUAL,         // Every element the same
+  DIST_COUNT
+} BenchDist;
+
+#define BENCH_FEW_UNIQUE 8
+
+const char *bench_dist_id(BenchDist dist);   // CLI name ("nearly", ...)
+const char *bench_dist_name(BenchDist dist); // UI label (French)
+int bench_dist_find(const char *id);         // -1 if unknown
+
+// Comma separated option lists of the bench/ tools, split in place with
+// strtok. Each fills at most max items and returns their count, or -1 after
+// telling why on stderr: more than max items, an item lookup() does not
+// know, a size that is not a positive int, a fraction outside [0, 1].
+int bench_parse_ids(char *arg, int (*lookup)(const char *), int *out,
+                    int max);
+int bench_parse_sizes(char *arg, int *out, int max);
+int bench_parse_fractions(char *arg, double *out, int max);
+
+// Fills arr with n values in [0, range) following dist. Same seed, same
+// data, whatever the core count (rng.h streams, filled in parallel). swaps
+// is the k of DIST_NEARLY_SORTED; < 0 picks n / 100.
+void bench_generate(int *arr, int n, BenchDist dist, unsigned int seed,
+                    int range, int swaps);
+
+// bench_generate with range 1000 and the default swap count
+void bench_fill(int *arr, int n, BenchDist dist, unsigned int seed);
+
+double bench_now_ms(void);
+
+// Copies input into work, runs sort_kernels[algo] on it and returns the
+// elapsed time in ms. Only the kernel call is timed.
+double bench_time_kernel(int algo, const int *input, int *work, int n);
+
+// Times parallel_sort_int with an explicit thread count (scaling runs)
+double bench_time_parallel(const int *input, int *work, int n, int threads);
+
+// Same measurement on boxed storage (one malloc per int, void* array), the
+// layout the sorting view used before TypedArray. Boxing is not timed.
+// Returns -1 for algorithms without a boxed version (radix).
+double bench_time_boxed(int algo, const int *input, int n);
+
+// One extra untimed run of the kernel with hardware counters around it, so
+// counting never overlaps a timed run. pc comes from perf_counters_open.
+void bench_count_kernel(int algo, const int *input, int *work, int n,
+                        PerfCounters *pc, PerfSample *out);
+
+// --- Repeated Measurements ---
+
+typedef struct {
+  int runs; // Timed runs (0: not measured)
+  double min, median, p95, mean, stddev;
+} BenchStats;
+
+// Summarises count samples (ms); samples is reordered
+void bench_stats(double *samples, int count, BenchStats *st);
+
+// Runs the kernel `warmup` times untimed, then `repeats` timed runs on the
+// same input. boxed selects bench_time_boxed (st->runs = 0 if unavailable).
+void bench_measure(int algo, int boxed, const int *input, int *work, int n,
+                   int warmup, int repeats, BenchStats *st);
+
+// --- Size Sweeps ---
+
+// Geometric sizes 2^lo_exp .. 2^hi_exp with per_octave points per doubling
+// (rounded, duplicates dropped). Writes at most max sizes, returns the count.
+int bench_geometric_sizes(int lo_exp, int hi_exp, int per_octave, int *out,
+                          int max);
+
+// Empirical complexity of one curve, fitted by least squares on log t.
+// The power fit has two free parameters and n log n one, so the raw R2
+// favours the power fit; the adjusted R2 charge each model for its
+// parameters and are the ones to compare.
+typedef struct {
+  double a, b;         // t = a * n^b
+  double r2;           // Of the power fit (log space)
+  double r2_adj;       // Adjusted for 2 parameters, NAN with 2 points
+  double a_nlogn;      // t = a_nlogn * n * log2(n)
+  double r2_nlogn;     // Same log space residuals as r2
+  double r2_nlogn_adj; // Adjusted for 1 parameter
+} BenchFit;
+
+// Fits the points with t > 0; returns 0 with fewer than 2 of them or a
+// single distinct n
+int bench_fit(const int *n, const double *t, int count, BenchFit *fit);
+
+#endif
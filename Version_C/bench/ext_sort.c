@@ -0,0 +1,179 @@
+// External merge sort of a raw binary file of ints or doubles (see
+// external_sort.h), with the time of each phase.
+//
+// Build (from Version_C/):
+//   gcc -O2 -o ext_sort bench/ext_sort.c external_sort.c sort.c bench.c
+//       typed_sort.c arena.c string_sort.c radix_sort.c parallel_sort.c
+//       simd_sort.c block_sort.c perf_counters.c shell_gaps.c rng.c
+//       -lpthread -lm
+//
+// Example:
+//   ./ext_sort -g 500000000 -t int donnees.bin      (2 Go de donnees)
+//   ./ext_sort -t int -a radix -m 512 donnees.bin donnees.trie -c
+
+#include "../bench.h"
+#include "../external_sort.h"
+#include "../sort.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "Usage: %s [options] ENTREE SORTIE\n"
+          "       %s -g N [-t TYPE] [-s SEED] FICHIER\n"
+          "  -t TYPE   int ou double (defaut: int)\n"
+          "  -a ALGO   tri des blocs en memoire (defaut: intro)\n"
+          "  -m MO     memoire de travail en Mo (defaut: 256)\n"
+          "  -r        ordre decroissant\n"
+          "  -T DIR    repertoire des fichiers temporaires (defaut: $TMPDIR)\n"
+          "  -c        verifier que la sortie est triee\n"
+          "  -g N      ecrire N valeurs aleatoires dans FICHIER\n"
+          "  -s SEED   graine pour -g (defaut: 1)\n",
+          prog, prog);
+}
+
+// Writes n random values in blocks (uniform in [0, 2^30))
+static int generate(const char *path, long long n, DataType type,
+                    unsigned int seed) {
+  FILE *f = fopen(path, "wb");
+  if (!f)
+    return -1;
+  enum { BLOCK = 1 << 20 };
+  int *keys = malloc(BLOCK * sizeof(int));
+  double *vals = malloc(BLOCK * sizeof(double));
+  int rc = 0;
+  for (long long done = 0; done < n && rc == 0; done += BLOCK) {
+    int k = n - done < BLOCK ? (int)(n - done) : BLOCK;
+    bench_generate(keys, k, DIST_UNIFORM, seed++, 1 << 30, -1);
+    size_t w;
+    if (type == TYPE_INT) {
+      w = fwrite(keys, sizeof(int), k, f);
+    } else {
+      for (int i = 0; i < k; i++)
+        vals[i] = keys[i] / 1024.0;
+      w = fwrite(vals, sizeof(double), k, f);
+    }
+    if (w != (size_t)k)
+      rc = -1;
+  }
+  free(keys);
+  free(vals);
+  if (fclose(f) != 0)
+    rc = -1;
+  return rc;
+}
+
+// Streams the file and checks the order; returns 1 when sorted
+static int check_sorted(const char *path, DataType type, int desc) {
+  FILE *f = fopen(path, "rb");
+  if (!f)
+    return 0;
+  size_t elem = type == TYPE_INT ? sizeof(int) : sizeof(double);
+  enum { BLOCK = 1 << 20 };
+  char *buf = malloc(BLOCK * elem);
+  double prev = 0;
+  int first = 1, ok = 1;
+  size_t got;
+  while (ok && (got = fread(buf, elem, BLOCK, f)) > 0)
+    for (size_t i = 0; i < got; i++) {
+      double v = type == TYPE_INT ? ((int *)buf)[i] : ((double *)buf)[i];
+      if (!first && (desc ? v > prev : v < prev)) {
+        ok = 0;
+        break;
+      }
+      prev = v;
+      first = 0;
+    }
+  free(buf);
+  fclose(f);
+  return ok;
+}
+
+int main(int argc, char **argv) {
+  DataType type = TYPE_INT;
+  int algo = ALGO_INTRO, desc = 0, check = 0;
+  size_t mem_mb = 256;
+  const char *tmp_dir = NULL;
+  long long gen_n = 0;
+  unsigned int seed = 1;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "t:a:m:rT:cg:s:h")) != -1) {
+    switch (opt) {
+    case 't':
+      if (strcmp(optarg, "int") == 0)
+        type = TYPE_INT;
+      else if (strcmp(optarg, "double") == 0)
+        type = TYPE_DOUBLE;
+      else {
+        usage(argv[0]);
+        return 1;
+      }
+      break;
+    case 'a':
+      algo = sort_kernel_find(optarg);
+      if (algo < 0) {
+        fprintf(stderr, "Inconnu: %s\n", optarg);
+        return 1;
+      }
+      break;
+    case 'm':
+      mem_mb = strtoul(optarg, NULL, 10);
+      break;
+    case 'r':
+      desc = 1;
+      break;
+    case 'T':
+      tmp_dir = optarg;
+      break;
+    case 'c':
+      check = 1;
+      break;
+    case 'g':
+      gen_n = strtoll(optarg, NULL, 10);
+      break;
+    case 's':
+      seed = (unsigned int)strtoul(optarg, NULL, 10);
+      break;
+    default:
+      usage(argv[0]);
+      return opt == 'h' ? 0 : 1;
+    }
+  }
+
+  if (gen_n > 0) {
+    if (optind + 1 != argc) {
+      usage(argv[0]);
+      return 1;
+    }
+    if (generate(argv[optind], gen_n, type, seed) != 0) {
+      perror(argv[optind]);
+      return 1;
+    }
+    return 0;
+  }
+  if (optind + 2 != argc) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  ExtSortStats st;
+  if (external_sort_file(argv[optind], argv[optind + 1], type, algo, desc,
+                         mem_mb << 20, tmp_dir, &st) != 0) {
+    perror("ext_sort");
+    return 1;
+  }
+  printf("%lld elements, %d runs, %d passe(s) de fusion\n", st.count,
+         st.runs, st.passes);
+  printf("lecture %.1f ms, tri %.1f ms, ecriture runs %.1f ms, "
+         "fusion %.1f ms, total %.1f ms\n",
+         st.read_ms, st.sort_ms, st.write_ms, st.merge_ms, st.total_ms);
+
+  if (check && !check_sorted(argv[optind + 1], type, desc)) {
+    fprintf(stderr, "ERREUR: sortie non triee\n");
+    return 1;
+  }
+  return 0;
+}
@@ -0,0 +1,55 @@
+// Consistency checks of the operation counts of op_count.c: every counting
+// kernel sorts and counts something, and TimSort's block moves (run copies,
+// gallop memmoves) are counted. Exits non-zero on the first failure.
+//
+// Build (from Version_C/):
+//   gcc -O2 -o op_check bench/op_check.c op_count.c sort.c bench.c
+//       typed_sort.c arena.c string_sort.c radix_sort.c parallel_sort.c
+//       simd_sort.c block_sort.c perf_counters.c shell_gaps.c rng.c
+//       -lpthread -lm
+
+#include "../bench.h"
+#include "../op_count.h"
+#include "../sort.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#define CHECK_N 2000
+#define RUN_N 100000
+
+int main(void) {
+  int *input = malloc(RUN_N * sizeof(int));
+  int *work = malloc(RUN_N * sizeof(int));
+  int failed = 0;
+  SortOps ops;
+
+  bench_fill(input, CHECK_N, DIST_UNIFORM, 1);
+  for (int a = 0; a < sort_kernel_count; a++) {
+    if (!sort_ops_supported(a))
+      continue;
+    sort_count_ops(a, input, work, CHECK_N, &ops);
+    if (!is_sorted_int(work, CHECK_N) || ops.cmp == 0 ||
+        ops.swaps + ops.moves == 0) {
+      fprintf(stderr, "ERREUR: %s n=%d: cmp=%lld swaps=%lld moves=%lld\n",
+              sort_kernels[a].id, CHECK_N, ops.cmp, ops.swaps, ops.moves);
+      failed = 1;
+    }
+  }
+
+  // Two ascending runs, the second below the first: TimSort merges them
+  // almost only with block copies, at least the smaller run into tmp and back
+  for (int i = 0; i < RUN_N; i++)
+    input[i] = (i + RUN_N / 2) % RUN_N;
+  sort_count_ops(ALGO_TIM, input, work, RUN_N, &ops);
+  if (!is_sorted_int(work, RUN_N) || ops.moves < RUN_N / 2) {
+    fprintf(stderr, "ERREUR: tim, deux sequences n=%d: moves=%lld\n", RUN_N,
+            ops.moves);
+    failed = 1;
+  }
+
+  if (!failed)
+    printf("Comptes d'operations: OK\n");
+  free(input);
+  free(work);
+  return failed;
+}
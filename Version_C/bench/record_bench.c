@@ -0,0 +1,186 @@
+// Record sort benchmark: records of 8 to 256 bytes sorted by their int key,
+// either moved directly or through a proxy (pointers, indices, key-index
+// pairs) followed by a gather pass, to see from which record size sorting
+// the proxy pays off. One CSV row per measurement.
+//
+// Build (from Version_C/):
+//   gcc -O2 -o record_bench bench/record_bench.c record_sort.c sort.c
+//       bench.c typed_sort.c arena.c string_sort.c radix_sort.c
+//       parallel_sort.c simd_sort.c block_sort.c perf_counters.c
+//       shell_gaps.c rng.c -lpthread -lm
+//
+// Example:
+//   ./record_bench -n 1000000 -z 8,16,64,256 -r 5
+//   ./record_bench -a intro,tim -n 100000,10000000 -z 64 -d uniform,nearly
+
+#include "../bench.h"
+#include "../record_sort.h"
+#include "../sort.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MAX_LIST 64
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "Usage: %s [options]\n"
+          "  -a LISTE  algorithmes par comparaison (defaut: intro)\n"
+          "  -l LISTE  dispositions (defaut: toutes)\n"
+          "  -z LISTE  tailles d'enregistrement en octets: 8, 16, 64, 256\n"
+          "            (defaut: toutes)\n"
+          "  -n LISTE  nombres d'enregistrements (defaut: 1000000)\n"
+          "  -d LISTE  distributions des cles (defaut: uniform)\n"
+          "  -r N      repetitions (defaut: 3)\n"
+          "  -s SEED   graine de base (defaut: 1)\n"
+          "  -o FICHIER  sortie CSV (defaut: stdout)\n"
+          "LISTE = valeurs separees par des virgules.\n",
+          prog);
+  fprintf(stderr, "Algorithmes:");
+  for (int a = 0; a < sort_kernel_count; a++)
+    if (sort_is_comparison(a))
+      fprintf(stderr, " %s", sort_kernels[a].id);
+  fprintf(stderr, "\nDispositions:");
+  for (int l = 0; l < RECORD_COUNT; l++)
+    fprintf(stderr, " %s", record_layout_id(l));
+  fprintf(stderr, "\nDistributions:");
+  for (int d = 0; d < DIST_COUNT; d++)
+    fprintf(stderr, " %s", bench_dist_id(d));
+  fprintf(stderr, "\n");
+}
+
+// Only the kernels of sort_gen.h apply to records
+static int comparison_find(const char *id) {
+  int a = sort_kernel_find(id);
+  return a >= 0 && sort_is_comparison(a) ? a : -1;
+}
+
+int main(int argc, char **argv) {
+  int algos[MAX_LIST] = {ALGO_INTRO}, layouts[MAX_LIST],
+      rec_sizes[MAX_LIST] = {8, 16, 64, 256}, sizes[MAX_LIST] = {1000000},
+      dists[MAX_LIST] = {DIST_UNIFORM};
+  int n_algos = 1, n_layouts = RECORD_COUNT, n_rec_sizes = 4, n_sizes = 1,
+      n_dists = 1;
+  int repeats = 3;
+  unsigned int seed = 1;
+  FILE *out = stdout;
+
+  for (int l = 0; l < RECORD_COUNT; l++)
+    layouts[l] = l;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "a:l:z:n:d:r:s:o:h")) != -1) {
+    switch (opt) {
+    case 'a':
+      n_algos = bench_parse_ids(optarg, comparison_find, algos, MAX_LIST);
+      break;
+    case 'l':
+      n_layouts =
+          bench_parse_ids(optarg, record_layout_find, layouts, MAX_LIST);
+      break;
+    case 'z':
+      n_rec_sizes = bench_parse_sizes(optarg, rec_sizes, MAX_LIST);
+      for (int z = 0; z < n_rec_sizes; z++)
+        if (!record_size_supported(rec_sizes[z])) {
+          fprintf(stderr, "Taille d'enregistrement invalide: %d\n",
+                  rec_sizes[z]);
+          n_rec_sizes = -1;
+          break;
+        }
+      break;
+    case 'n':
+      n_sizes = bench_parse_sizes(optarg, sizes, MAX_LIST);
+      break;
+    case 'd':
+      n_dists = bench_parse_ids(optarg, bench_dist_find, dists, MAX_LIST);
+      break;
+    case 'r':
+      repeats = atoi(optarg);
+      break;
+    case 's':
+      seed = (unsigned int)strtoul(optarg, NULL, 10);
+      break;
+    case 'o':
+      out = fopen(optarg, "w");
+      if (!out) {
+        perror(optarg);
+        return 1;
+      }
+      break;
+    default:
+      usage(argv[0]);
+      return opt == 'h' ? 0 : 1;
+    }
+  }
+  if (n_algos <= 0 || n_layouts <= 0 || n_rec_sizes <= 0 || n_sizes <= 0 ||
+      n_dists <= 0 || repeats <= 0) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  int failed = 0;
+  fprintf(out, "algo,layout,size,n,dist,seed,rep,sort_ms,gather_ms,"
+               "total_ms\n");
+  for (int d = 0; d < n_dists; d++) {
+    for (int i = 0; i < n_sizes; i++) {
+      int n = sizes[i];
+      int *keys = malloc((size_t)n * sizeof(int));
+      if (!keys) {
+        fprintf(stderr, "Memoire insuffisante: n=%d\n", n);
+        return 1;
+      }
+      for (int r = 0; r < repeats; r++) {
+        // Every algorithm and layout sorts the same keys for a given
+        // (dist, n, rep), whatever the record size
+        unsigned int run_seed = seed + r;
+        bench_fill(keys, n, dists[d], run_seed);
+        for (int z = 0; z < n_rec_sizes; z++) {
+          int size = rec_sizes[z];
+          void *input = record_alloc(keys, n, size);
+          void *output = malloc((size_t)n * size);
+          if (!input || !output) {
+            fprintf(stderr, "Memoire insuffisante: n=%d, %d octets\n", n,
+                    size);
+            free(input);
+            free(output);
+            free(keys);
+            return 1;
+          }
+          for (int a = 0; a < n_algos; a++) {
+            for (int l = 0; l < n_layouts; l++) {
+              double sort_ms, gather_ms;
+              if (record_sort(layouts[l], algos[a], input, output, n, size,
+                              &sort_ms, &gather_ms) != 0) {
+                fprintf(stderr, "Memoire insuffisante: %s n=%d\n",
+                        record_layout_id(layouts[l]), n);
+                free(input);
+                free(output);
+                free(keys);
+                return 1;
+              }
+              if (!record_check(output, n, size)) {
+                fprintf(stderr, "ERREUR: %s/%s %d octets n=%d non trie\n",
+                        sort_kernels[algos[a]].id,
+                        record_layout_id(layouts[l]), size, n);
+                failed = 1;
+              }
+              fprintf(out, "%s,%s,%d,%d,%s,%u,%d,%.6f,%.6f,%.6f\n",
+                      sort_kernels[algos[a]].id, record_layout_id(layouts[l]),
+                      size, n, bench_dist_id(dists[d]), run_seed, r, sort_ms,
+                      gather_ms, sort_ms + gather_ms);
+              fflush(out);
+            }
+          }
+          free(input);
+          free(output);
+        }
+      }
+      free(keys);
+    }
+  }
+
+  if (out != stdout)
+    fclose(out);
+  return failed;
+}
@@ -0,0 +1,384 @@
+// Headless sort benchmark: runs the kernels of sort.c without GTK and writes
+// one CSV row per measurement.
+//
+// Build (from Version_C/):
+//   gcc -O2 -o sort_bench bench/sort_bench.c sort.c bench.c typed_sort.c
+//       arena.c string_sort.c radix_sort.c parallel_sort.c simd_sort.c
+//       block_sort.c perf_counters.c shell_gaps.c rng.c -lpthread -lm
+//
+// Example:
+//   ./sort_bench -a shell,quick -n 1000,10000 -d uniform,sorted -r 5 -s 42
+//   ./sort_bench -a parallel -n 10000000 -t 1,2,4,8,16 -r 3   (scaling)
+//   ./sort_bench -a quick,simd -n 1000,100000,10000000,100000000 -r 3
+//       -R 1000000000   (full range: few duplicates, see below)
+//   ./sort_bench -a shell,intro -n 100000 -w 2 -r 15 -S   (median, p95...)
+//   ./sort_bench -a insertion,shell -n 20000 -p   (hardware counters)
+//   ./sort_bench -a tim,intro -n 1000000 -P 0,0.0001,0.001,0.01,0.1 -S
+//   ./sort_bench -a quick,intro,block -n 1000000 -p -S   (branch misses)
+//   ./sort_bench -a intro,radix,block -g 8:24:2 -S   (log-scale sweep)
+//   ./sort_bench -a shell -n 1000000 -G shell,ciura,tokuda,sedgewick -S
+//
+// Values are drawn in [0, 1000) by default, as in the GUI. Past a few
+// hundred thousand elements that is mostly duplicates, on which the Lomuto
+// partition of 'quick' goes quadratic: large sizes need a wider -R.
+
+#include "../bench.h"
+#include "../parallel_sort.h"
+#include "../shell_gaps.h"
+#include "../sort.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MAX_LIST 64
+#define MAX_RANGE (1 << 30)
+#define MAX_ZIPF_RANGE (1 << 24) // DIST_ZIPF keeps a double per value
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "Usage: %s [options]\n"
+          "  -a LISTE  algorithmes (defaut: tous)\n"
+          "  -n LISTE  tailles de tableau (defaut: 1000,2000,4000)\n"
+          "  -g A:B[:K]  tailles geometriques 2^A .. 2^B, K par octave\n"
+          "            (defaut K = 1), a la place de -n\n"
+          "  -d LISTE  distributions (defaut: uniform)\n"
+          "  -R N      valeurs tirees dans [0, N) (defaut: 1000)\n"
+          "  -r N      repetitions par taille (defaut: 3)\n"
+          "  -w N      executions d'echauffement non mesurees (defaut: 1)\n"
+          "  -S        resume: une ligne min/mediane/p95/moyenne/ecart-type\n"
+          "            par point, les repetitions triant la meme entree\n"
+          "  -s SEED   graine de base (defaut: 1)\n"
+          "  -o FICHIER  sortie CSV (defaut: stdout)\n"
+          "  -b        mesurer aussi le stockage void** (reference)\n"
+          "  -t LISTE  threads pour 'parallel' (defaut: nombre de coeurs)\n"
+          "  -G LISTE  suites d'ecarts pour 'shell' (defaut: ciura), lignes\n"
+          "            nommees shell-<suite>\n"
+          "  -p        colonnes de compteurs materiels (perf_event), mesurees\n"
+          "            sur une execution supplementaire non chronometree\n"
+          "  -P LISTE  axe de pre-tri a la place de -d: entree triee puis\n"
+          "            fraction*n echanges aleatoires (colonne disorder)\n"
+          "LISTE = valeurs separees par des virgules.\n",
+          prog);
+  fprintf(stderr, "Algorithmes:");
+  for (int a = 0; a < sort_kernel_count; a++)
+    fprintf(stderr, " %s", sort_kernels[a].id);
+  fprintf(stderr, "\nDistributions:");
+  for (int d = 0; d < DIST_COUNT; d++)
+    fprintf(stderr, " %s", bench_dist_id(d));
+  fprintf(stderr, "\nEcarts:");
+  for (int g = 0; g < GAPS_COUNT; g++)
+    fprintf(stderr, " %s", shell_gaps_id(g));
+  fprintf(stderr, "\n");
+}
+
+// -P: disorder fractions replacing the distribution axis
+static double disorder[MAX_LIST];
+static int with_disorder = 0;
+
+// -R: values in [0, range)
+static int range = 1000;
+
+// Input of distribution point d: dists[d], or with -P a sorted array
+// disturbed by disorder[d] * n random swaps
+static void fill_input(int *input, int n, BenchDist dist, int d,
+                       unsigned int seed) {
+  if (with_disorder)
+    bench_generate(input, n, DIST_NEARLY_SORTED, seed, range,
+                   (int)(disorder[d] * n + 0.5));
+  else
+    bench_generate(input, n, dist, seed, range, -1);
+}
+
+// "dist" column, followed by the disorder column with -P
+static const char *dist_label(BenchDist dist, int d) {
+  static char buf[48];
+  if (!with_disorder)
+    return bench_dist_id(dist);
+  snprintf(buf, sizeof(buf), "%s,%g", bench_dist_id(dist), disorder[d]);
+  return buf;
+}
+
+// -G: the shell kernel is swept over gap sequences like parallel over threads
+static int with_gaps = 0;
+
+// "algo" column: with -G, shell rows carry the current gap sequence
+static const char *algo_label(int algo) {
+  static char buf[32];
+  if (!with_gaps || algo != ALGO_SHELL)
+    return sort_kernels[algo].id;
+  snprintf(buf, sizeof(buf), "shell-%s", shell_gaps_id(shell_get_gaps()));
+  return buf;
+}
+
+static int with_counters = 0;
+static PerfCounters counters;
+static int counters_ok = 0;
+
+static void print_header(FILE *out, const char *columns) {
+  fputs(columns, out);
+  for (int c = 0; with_counters && c < PC_COUNT; c++)
+    fprintf(out, ",%s", perf_counter_id(c));
+  fputc('\n', out);
+}
+
+// Ends a row: counter columns (empty when not measured) and newline.
+// hw is NULL for rows without counters (boxed storage).
+static void end_row(FILE *out, const PerfSample *hw) {
+  for (int c = 0; with_counters && c < PC_COUNT; c++) {
+    if (hw && (hw->valid & (1u << c)))
+      fprintf(out, ",%lld", hw->value[c]);
+    else
+      fputc(',', out);
+  }
+  fputc('\n', out);
+}
+
+// Extra untimed run under perf_event; empty sample if unavailable
+static void count_run(int algo, const int *input, int *work, int n,
+                      PerfSample *hw) {
+  hw->valid = 0;
+  if (counters_ok)
+    bench_count_kernel(algo, input, work, n, &counters, hw);
+}
+
+int main(int argc, char **argv) {
+  int algos[MAX_LIST], sizes[MAX_LIST] = {1000, 2000, 4000},
+                       dists[MAX_LIST] = {DIST_UNIFORM};
+  int n_algos = sort_kernel_count, n_sizes = 3, n_dists = 1, n_disorder = 0;
+  int repeats = 3, warmup = 1;
+  int with_boxed = 0, summary = 0;
+  int threads[MAX_LIST] = {parallel_default_threads()}, n_threads = 1;
+  int gaps[MAX_LIST] = {SHELL_GAPS_DEFAULT}, n_gaps = 1;
+  unsigned int seed = 1;
+  FILE *out = stdout;
+
+  for (int a = 0; a < sort_kernel_count; a++)
+    algos[a] = a;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "a:n:g:d:R:r:w:s:o:t:G:P:bpSh")) != -1) {
+    switch (opt) {
+    case 'a':
+      n_algos = bench_parse_ids(optarg, sort_kernel_find, algos, MAX_LIST);
+      break;
+    case 'n':
+      n_sizes = bench_parse_sizes(optarg, sizes, MAX_LIST);
+      break;
+    case 'g': {
+      int lo, hi, per_octave = 1;
+      if (sscanf(optarg, "%d:%d:%d", &lo, &hi, &per_octave) < 2 || lo < 1 ||
+          hi < lo || hi > 30) {
+        fprintf(stderr, "Balayage invalide: %s\n", optarg);
+        n_sizes = -1;
+        break;
+      }
+      // One slot more than MAX_LIST tells a sweep that does not fit
+      int sweep[MAX_LIST + 1];
+      n_sizes = bench_geometric_sizes(lo, hi, per_octave, sweep, MAX_LIST + 1);
+      if (n_sizes > MAX_LIST) {
+        fprintf(stderr, "Balayage trop long (max %d tailles): %s\n", MAX_LIST,
+                optarg);
+        n_sizes = -1;
+        break;
+      }
+      memcpy(sizes, sweep, n_sizes * sizeof(int));
+      break;
+    }
+    case 'd':
+      n_dists = bench_parse_ids(optarg, bench_dist_find, dists, MAX_LIST);
+      break;
+    case 'R': {
+      char *end;
+      long r = strtol(optarg, &end, 10);
+      if (*end || r < 1 || r > MAX_RANGE) {
+        fprintf(stderr, "Plage invalide: %s\n", optarg);
+        n_dists = -1;
+        break;
+      }
+      range = (int)r;
+      break;
+    }
+    case 'r':
+      repeats = atoi(optarg);
+      break;
+    case 'w':
+      warmup = atoi(optarg);
+      break;
+    case 'p':
+      with_counters = 1;
+      break;
+    case 'P':
+      n_disorder = bench_parse_fractions(optarg, disorder, MAX_LIST);
+      with_disorder = 1;
+      break;
+    case 'S':
+      summary = 1;
+      break;
+    case 's':
+      seed = (unsigned int)strtoul(optarg, NULL, 10);
+      break;
+    case 't':
+      n_threads = bench_parse_sizes(optarg, threads, MAX_LIST);
+      break;
+    case 'G':
+      n_gaps = bench_parse_ids(optarg, shell_gaps_find, gaps, MAX_LIST);
+      with_gaps = 1;
+      break;
+    case 'b':
+      with_boxed = 1;
+      break;
+    case 'o':
+      out = fopen(optarg, "w");
+      if (!out) {
+        perror(optarg);
+        return 1;
+      }
+      break;
+    default:
+      usage(argv[0]);
+      return opt == 'h' ? 0 : 1;
+    }
+  }
+  if (with_disorder)
+    n_dists = n_disorder;
+  if (n_algos <= 0 || n_sizes <= 0 || n_dists <= 0 || n_threads <= 0 ||
+      n_gaps <= 0 || repeats <= 0 || warmup < 0) {
+    usage(argv[0]);
+    return 1;
+  }
+  for (int d = 0; with_disorder && d < n_dists; d++)
+    dists[d] = DIST_NEARLY_SORTED;
+  for (int d = 0; d < n_dists; d++)
+    if (dists[d] == DIST_ZIPF && range > MAX_ZIPF_RANGE) {
+      fprintf(stderr, "Plage trop grande pour zipf: %d (max %d)\n", range,
+              MAX_ZIPF_RANGE);
+      return 1;
+    }
+
+  int max_n = 0;
+  for (int i = 0; i < n_sizes; i++)
+    if (sizes[i] > max_n)
+      max_n = sizes[i];
+  int *input = malloc(max_n * sizeof(int));
+  int *work = malloc(max_n * sizeof(int));
+  int failed = 0;
+
+  if (with_counters) {
+    counters_ok = perf_counters_open(&counters) > 0;
+    if (!counters_ok)
+      fprintf(stderr, "Compteurs materiels indisponibles: colonnes vides\n");
+  }
+
+  if (summary) {
+    print_header(out, with_disorder
+                          ? "algo,storage,threads,n,dist,disorder,seed,warmup,"
+                            "runs,min_ms,median_ms,p95_ms,mean_ms,stddev_ms"
+                          : "algo,storage,threads,n,dist,seed,warmup,runs,"
+                            "min_ms,median_ms,p95_ms,mean_ms,stddev_ms");
+    for (int d = 0; d < n_dists; d++) {
+      for (int i = 0; i < n_sizes; i++) {
+        int n = sizes[i];
+        fill_input(input, n, dists[d], d, seed);
+        for (int a = 0; a < n_algos; a++) {
+          int parallel = algos[a] == ALGO_PARALLEL;
+          int shell = algos[a] == ALGO_SHELL;
+          int variants = parallel ? n_threads : shell ? n_gaps : 1;
+          for (int t = 0; t < variants; t++) {
+            int nt = parallel ? threads[t] : 1;
+            parallel_set_threads(nt);
+            shell_set_gaps(gaps[shell ? t : 0]);
+            BenchStats st;
+            bench_measure(algos[a], 0, input, work, n, warmup, repeats, &st);
+            if (!is_sorted_int(work, n)) {
+              fprintf(stderr, "ERREUR: %s n=%d non trie\n",
+                      algo_label(algos[a]), n);
+              failed = 1;
+            }
+            PerfSample hw;
+            count_run(algos[a], input, work, n, &hw);
+            fprintf(out, "%s,typed,%d,%d,%s,%u,%d,%d,%.6f,%.6f,%.6f,%.6f,%.6f",
+                    algo_label(algos[a]), nt, n, dist_label(dists[d], d),
+                    seed, warmup, st.runs, st.min, st.median, st.p95, st.mean,
+                    st.stddev);
+            end_row(out, &hw);
+          }
+          if (with_boxed) {
+            BenchStats st;
+            bench_measure(algos[a], 1, input, work, n, warmup, repeats, &st);
+            if (st.runs > 0) {
+              fprintf(out, "%s,boxed,1,%d,%s,%u,%d,%d,%.6f,%.6f,%.6f,%.6f,%.6f",
+                      algo_label(algos[a]), n, dist_label(dists[d], d),
+                      seed, warmup, st.runs, st.min, st.median, st.p95,
+                      st.mean, st.stddev);
+              end_row(out, NULL);
+            }
+          }
+          fflush(out);
+        }
+      }
+    }
+    goto done;
+  }
+
+  print_header(out, with_disorder
+                        ? "algo,storage,threads,n,dist,disorder,seed,rep,"
+                          "time_ms"
+                        : "algo,storage,threads,n,dist,seed,rep,time_ms");
+  for (int d = 0; d < n_dists; d++) {
+    for (int i = 0; i < n_sizes; i++) {
+      int n = sizes[i];
+      for (int r = 0; r < repeats; r++) {
+        // Every algorithm sorts the same input for a given (dist, n, rep)
+        unsigned int run_seed = seed + r;
+        fill_input(input, n, dists[d], d, run_seed);
+        for (int a = 0; a < n_algos; a++) {
+          // Untimed warmup before the first repetition of each point
+          for (int w = 0; r == 0 && w < warmup; w++) {
+            parallel_set_threads(threads[0]);
+            shell_set_gaps(gaps[0]);
+            bench_time_kernel(algos[a], input, work, n);
+          }
+          // Only the parallel kernel is swept over thread counts, and only
+          // shell over gap sequences
+          int parallel = algos[a] == ALGO_PARALLEL;
+          int shell = algos[a] == ALGO_SHELL;
+          int variants = parallel ? n_threads : shell ? n_gaps : 1;
+          for (int t = 0; t < variants; t++) {
+            int nt = parallel ? threads[t] : 1;
+            parallel_set_threads(nt);
+            shell_set_gaps(gaps[shell ? t : 0]);
+            double ms = bench_time_kernel(algos[a], input, work, n);
+            if (!is_sorted_int(work, n)) {
+              fprintf(stderr, "ERREUR: %s n=%d non trie\n",
+                      algo_label(algos[a]), n);
+              failed = 1;
+            }
+            PerfSample hw;
+            count_run(algos[a], input, work, n, &hw);
+            fprintf(out, "%s,typed,%d,%d,%s,%u,%d,%.6f",
+                    algo_label(algos[a]), nt, n, dist_label(dists[d], d),
+                    run_seed, r, ms);
+            end_row(out, &hw);
+          }
+          if (with_boxed && sort_is_comparison(algos[a])) {
+            fprintf(out, "%s,boxed,1,%d,%s,%u,%d,%.6f",
+                    algo_label(algos[a]), n, dist_label(dists[d], d),
+                    run_seed, r, bench_time_boxed(algos[a], input, n));
+            end_row(out, NULL);
+          }
+          fflush(out);
+        }
+      }
+    }
+  }
+
+done:
+  if (counters_ok)
+    perf_counters_close(&counters);
+  free(input);
+  free(work);
+  if (out != stdout)
+    fclose(out);
+  return failed;
+}
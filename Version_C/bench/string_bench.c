@@ -0,0 +1,217 @@
+// String sort benchmark: the multikey quicksort (ALGO_RADIX on TYPE_STRING)
+// against the comparison sorts, on char** (strcmp inlined), on boxed void**
+// storage (what cmp_generic sorts in the interface) and through libc qsort.
+// One CSV row per measurement.
+//
+// Build (from Version_C/):
+//   gcc -O2 -o string_bench bench/string_bench.c string_sort.c typed_sort.c
+//       arena.c sort.c bench.c radix_sort.c parallel_sort.c simd_sort.c
+//       block_sort.c perf_counters.c shell_gaps.c rng.c -lpthread -lm
+//
+// Example:
+//   ./string_bench -n 100000,1000000 -l 16 -p 8 -r 5
+//   ./string_bench -n 1000000 -d fewunique,sorted -l 32 -p 24
+
+#include "../bench.h"
+#include "../sort.h"
+#include "../typed_sort.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define MAX_LIST 64
+
+typedef enum {
+  SB_MKQS,  // typed_sort ALGO_RADIX: multikey quicksort
+  SB_QUICK, // typed_sort ALGO_QUICK on char**
+  SB_INTRO, // typed_sort ALGO_INTRO on char**
+  SB_BOXED, // boxed_sort ALGO_QUICK on void** (generic quicksort)
+  SB_QSORT, // libc qsort + strcmp callback
+  SB_COUNT
+} StringAlgo;
+
+static const char *sb_ids[SB_COUNT] = {"mkqs", "quick", "intro", "boxed",
+                                       "qsort"};
+
+static int sb_find(const char *id) {
+  for (int a = 0; a < SB_COUNT; a++)
+    if (strcmp(sb_ids[a], id) == 0)
+      return a;
+  return -1;
+}
+
+static void usage(const char *prog) {
+  fprintf(stderr,
+          "Usage: %s [options]\n"
+          "  -a LISTE  algorithmes (defaut: tous)\n"
+          "  -n LISTE  nombres de chaines (defaut: 100000)\n"
+          "  -d LISTE  distributions des cles (defaut: uniform)\n"
+          "  -l N      longueur des chaines (defaut: 16)\n"
+          "  -p N      longueur du prefixe commun (defaut: 0)\n"
+          "  -r N      repetitions (defaut: 3)\n"
+          "  -s SEED   graine de base (defaut: 1)\n"
+          "  -o FICHIER  sortie CSV (defaut: stdout)\n"
+          "LISTE = valeurs separees par des virgules.\n",
+          prog);
+  fprintf(stderr, "Algorithmes:");
+  for (int a = 0; a < SB_COUNT; a++)
+    fprintf(stderr, " %s", sb_ids[a]);
+  fprintf(stderr, "\nDistributions:");
+  for (int d = 0; d < DIST_COUNT; d++)
+    fprintf(stderr, " %s", bench_dist_id(d));
+  fprintf(stderr, "\n");
+}
+
+// Strings of len chars: prefix times 'p', then the key in base 26 padded
+// with 'a', so string order follows the key distribution
+static void generate_strings(TypedArray *ta, int n, int len, int prefix,
+                             BenchDist dist, unsigned int seed) {
+  int digits = len - prefix < 6 ? len - prefix : 6;
+  int range = 1;
+  for (int i = 0; i < digits; i++)
+    range *= 26;
+  int *keys = malloc(n * sizeof(int));
+  bench_generate(keys, n, dist, seed, range, -1);
+
+  typed_array_alloc(ta, TYPE_STRING, n, len);
+  for (int i = 0; i < n; i++) {
+    char *s = ta->strs[i];
+    memset(s, 'p', prefix);
+    memset(s + prefix, 'a', len - prefix);
+    for (int k = keys[i], c = len - 1; c >= len - digits; c--, k /= 26)
+      s[c] = 'a' + k % 26;
+  }
+  free(keys);
+}
+
+static int cmp_str(const void *a, const void *b) {
+  return strcmp(*(char *const *)a, *(char *const *)b);
+}
+
+static int is_sorted_str(char *const *strs, int n) {
+  for (int i = 1; i < n; i++)
+    if (strcmp(strs[i - 1], strs[i]) > 0)
+      return 0;
+  return 1;
+}
+
+// Sorts a copy of input; boxing for SB_BOXED is not timed
+static double time_string_sort(int algo, const TypedArray *input,
+                               Arena *arena, int *sorted) {
+  TypedArray work;
+  typed_array_copy(&work, input);
+  int n = work.n;
+  double t0, ms;
+
+  if (algo == SB_BOXED) {
+    void **boxed = typed_box(&work, arena);
+    t0 = bench_now_ms();
+    boxed_sort(boxed, n, TYPE_STRING, ALGO_QUICK, 0);
+    ms = bench_now_ms() - t0;
+    typed_unbox(&work, boxed, arena);
+  } else {
+    t0 = bench_now_ms();
+    if (algo == SB_QSORT)
+      qsort(work.strs, n, sizeof(char *), cmp_str);
+    else
+      typed_sort(&work,
+                 algo == SB_MKQS    ? ALGO_RADIX
+                 : algo == SB_QUICK ? ALGO_QUICK
+                                    : ALGO_INTRO,
+                 0);
+    ms = bench_now_ms() - t0;
+  }
+
+  *sorted = is_sorted_str(work.strs, n);
+  typed_array_free(&work);
+  return ms;
+}
+
+int main(int argc, char **argv) {
+  int algos[MAX_LIST], sizes[MAX_LIST] = {100000},
+                       dists[MAX_LIST] = {DIST_UNIFORM};
+  int n_algos = SB_COUNT, n_sizes = 1, n_dists = 1;
+  int len = 16, prefix = 0, repeats = 3;
+  unsigned int seed = 1;
+  FILE *out = stdout;
+
+  for (int a = 0; a < SB_COUNT; a++)
+    algos[a] = a;
+
+  int opt;
+  while ((opt = getopt(argc, argv, "a:n:d:l:p:r:s:o:h")) != -1) {
+    switch (opt) {
+    case 'a':
+      n_algos = bench_parse_ids(optarg, sb_find, algos, MAX_LIST);
+      break;
+    case 'n':
+      n_sizes = bench_parse_sizes(optarg, sizes, MAX_LIST);
+      break;
+    case 'd':
+      n_dists = bench_parse_ids(optarg, bench_dist_find, dists, MAX_LIST);
+      break;
+    case 'l':
+      len = atoi(optarg);
+      break;
+    case 'p':
+      prefix = atoi(optarg);
+      break;
+    case 'r':
+      repeats = atoi(optarg);
+      break;
+    case 's':
+      seed = (unsigned int)strtoul(optarg, NULL, 10);
+      break;
+    case 'o':
+      out = fopen(optarg, "w");
+      if (!out) {
+        perror(optarg);
+        return 1;
+      }
+      break;
+    default:
+      usage(argv[0]);
+      return opt == 'h' ? 0 : 1;
+    }
+  }
+  if (n_algos <= 0 || n_sizes <= 0 || n_dists <= 0 || repeats <= 0 ||
+      len <= 0 || prefix < 0 || prefix >= len) {
+    usage(argv[0]);
+    return 1;
+  }
+
+  Arena arena = {0};
+  int failed = 0;
+
+  fprintf(out, "algo,n,len,prefix,dist,seed,rep,time_ms\n");
+  for (int d = 0; d < n_dists; d++) {
+    for (int i = 0; i < n_sizes; i++) {
+      int n = sizes[i];
+      for (int r = 0; r < repeats; r++) {
+        // Every algorithm sorts the same strings for a given (dist, n, rep)
+        unsigned int run_seed = seed + r;
+        TypedArray input;
+        generate_strings(&input, n, len, prefix, dists[d], run_seed);
+        for (int a = 0; a < n_algos; a++) {
+          int sorted;
+          double ms = time_string_sort(algos[a], &input, &arena, &sorted);
+          if (!sorted) {
+            fprintf(stderr, "ERREUR: %s n=%d non trie\n", sb_ids[algos[a]],
+                    n);
+            failed = 1;
+          }
+          fprintf(out, "%s,%d,%d,%d,%s,%u,%d,%.6f\n", sb_ids[algos[a]], n,
+                  len, prefix, bench_dist_id(dists[d]), run_seed, r, ms);
+          fflush(out);
+        }
+        typed_array_free(&input);
+      }
+    }
+  }
+
+  arena_free(&arena);
+  if (out != stdout)
+    fclose(out);
+  return failed;
+}
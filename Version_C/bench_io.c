@@ -0,0 +1,332 @@
+#define _GNU_SOURCE // gethostname()
+#include "bench_io.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/utsname.h>
+#include <time.h>
+#include <unistd.h>
+
+#define LINE_MAX_LEN 1024
+#define CSV_MAX_COLS 48
+
+static int has_suffix(const char *s, const char *suffix) {
+  size_t n = strlen(s), k = strlen(suffix);
+  return n >= k && strcmp(s + n - k, suffix) == 0;
+}
+
+ResultsFormat bench_results_format_for(const char *path) {
+  return has_suffix(path, ".json") ? RESULTS_JSON : RESULTS_CSV;
+}
+
+// --- Machine Info ---
+
+static void cpu_model(char *out, size_t size) {
+  snprintf(out, size, "?");
+  FILE *f = fopen("/proc/cpuinfo", "r");
+  if (!f)
+    return;
+  char line[LINE_MAX_LEN];
+  while (fgets(line, sizeof(line), f)) {
+    char *colon = strchr(line, ':');
+    if (strncmp(line, "model name", 10) == 0 && colon) {
+      snprintf(out, size, "%s", colon + 2);
+      out[strcspn(out, "\n")] = '\0';
+      break;
+    }
+  }
+  fclose(f);
+}
+
+void bench_machine_info(BenchMachine *m) {
+  memset(m, 0, sizeof(*m));
+  if (gethostname(m->host, sizeof(m->host) - 1) != 0)
+    snprintf(m->host, sizeof(m->host), "?");
+  cpu_model(m->cpu, sizeof(m->cpu));
+  struct utsname u;
+  if (uname(&u) == 0)
+    snprintf(m->os, sizeof(m->os), "%.31s %.63s %.31s", u.sysname,
+             u.release, u.machine);
+  m->cores = (int)sysconf(_SC_NPROCESSORS_ONLN);
+#ifdef __VERSION__
+  snprintf(m->compiler, sizeof(m->compiler), "%s", __VERSION__);
+#endif
+  time_t now = time(NULL);
+  strftime(m->date, sizeof(m->date), "%Y-%m-%dT%H:%M:%S", localtime(&now));
+}
+
+// --- Saving ---
+
+static void csv_save(FILE *f, const BenchMachine *m, const BenchRecord *recs,
+                     int count) {
+  fprintf(f, "# host: %s\n# cpu: %s\n# os: %s\n# cores: %d\n# compiler: %s\n"
+             "# date: %s\n",
+          m->host, m->cpu, m->os, m->cores, m->compiler, m->date);
+  fprintf(f, "algo,storage,threads,n,dist,disorder,seed,warmup,runs,min_ms,"
+             "median_ms,p95_ms,mean_ms,stddev_ms,boxed_median_ms");
+  for (int c = 0; c < PC_COUNT; c++)
+    fprintf(f, ",%s", perf_counter_id(c));
+  fputc('\n', f);
+
+  for (int i = 0; i < count; i++) {
+    const BenchRecord *r = &recs[i];
+    fprintf(f, "%s,%s,%d,%d,%s,", r->algo, r->storage, r->threads, r->n,
+            r->dist);
+    if (r->disorder >= 0)
+      fprintf(f, "%g", r->disorder);
+    fprintf(f, ",%u,%d,%d,%.6f,%.6f,%.6f,%.6f,%.6f,", r->seed, r->warmup,
+            r->st.runs, r->st.min, r->st.median, r->st.p95, r->st.mean,
+            r->st.stddev);
+    if (r->boxed_ms >= 0)
+      fprintf(f, "%.6f", r->boxed_ms);
+    for (int c = 0; c < PC_COUNT; c++) {
+      if (r->hw.valid & (1u << c))
+        fprintf(f, ",%lld", r->hw.value[c]);
+      else
+        fputc(',', f);
+    }
+    fputc('\n', f);
+  }
+}
+
+// Machine strings may hold anything; runs only hold ids and numbers
+static void json_string(FILE *f, const char *s) {
+  fputc('"', f);
+  for (; *s; s++) {
+    if (*s == '"' || *s == '\\')
+      fputc('\\', f);
+    if ((unsigned char)*s >= 0x20)
+      fputc(*s, f);
+  }
+  fputc('"', f);
+}
+
+static void json_save(FILE *f, const BenchMachine *m, const BenchRecord *recs,
+                      int count) {
+  fprintf(f, "{\n  \"machine\": {\"host\": ");
+  json_string(f, m->host);
+  fprintf(f, ", \"cpu\": ");
+  json_string(f, m->cpu);
+  fprintf(f, ", \"os\": ");
+  json_string(f, m->os);
+  fprintf(f, ", \"cores\": %d, \"compiler\": ", m->cores);
+  json_string(f, m->compiler);
+  fprintf(f, ", \"date\": ");
+  json_string(f, m->date);
+  fprintf(f, "},\n  \"runs\": [\n");
+
+  for (int i = 0; i < count; i++) {
+    const BenchRecord *r = &recs[i];
+    fprintf(f,
+            "    {\"algo\": \"%s\", \"storage\": \"%s\", \"threads\": %d, "
+            "\"n\": %d, \"dist\": \"%s\", ",
+            r->algo, r->storage, r->threads, r->n, r->dist);
+    if (r->disorder >= 0)
+      fprintf(f, "\"disorder\": %g, ", r->disorder);
+    fprintf(f,
+            "\"seed\": %u, \"warmup\": %d, \"runs\": %d, \"min_ms\": %.6f, "
+            "\"median_ms\": %.6f, \"p95_ms\": %.6f, \"mean_ms\": %.6f, "
+            "\"stddev_ms\": %.6f",
+            r->seed, r->warmup, r->st.runs, r->st.min, r->st.median,
+            r->st.p95, r->st.mean, r->st.stddev);
+    if (r->boxed_ms >= 0)
+      fprintf(f, ", \"boxed_median_ms\": %.6f", r->boxed_ms);
+    for (int c = 0; c < PC_COUNT; c++)
+      if (r->hw.valid & (1u << c))
+        fprintf(f, ", \"%s\": %lld", perf_counter_id(c), r->hw.value[c]);
+    fprintf(f, "}%s\n", i + 1 < count ? "," : "");
+  }
+  fprintf(f, "  ]\n}\n");
+}
+
+int bench_results_save(const char *path, ResultsFormat fmt,
+                       const BenchMachine *m, const BenchRecord *recs,
+                       int count) {
+  FILE *f = fopen(path, "w");
+  if (!f)
+    return -1;
+  if (fmt == RESULTS_JSON)
+    json_save(f, m, recs, count);
+  else
+    csv_save(f, m, recs, count);
+  int err = ferror(f);
+  if (fclose(f) != 0)
+    return -1;
+  if (err) {
+    errno = EIO;
+    return -1;
+  }
+  return 0;
+}
+
+// --- Loading ---
+// Both formats go through set_field: one named value at a time
+
+static void record_init(BenchRecord *r) {
+  memset(r, 0, sizeof(*r));
+  strcpy(r->storage, "typed");
+  r->threads = 1;
+  r->disorder = -1;
+  r->boxed_ms = -1;
+}
+
+static void copy_id(char *dst, size_t size, const char *src) {
+  size_t len = strnlen(src, size - 1); // Longer ids are cut
+  memcpy(dst, src, len);
+  dst[len] = '\0';
+}
+
+// Empty values (missing counters, no boxed run) leave the default
+static void set_field(BenchRecord *r, const char *key, const char *val) {
+  if (!*val)
+    return;
+  if (strcmp(key, "algo") == 0)
+    copy_id(r->algo, sizeof(r->algo), val);
+  else if (strcmp(key, "storage") == 0)
+    copy_id(r->storage, sizeof(r->storage), val);
+  else if (strcmp(key, "dist") == 0)
+    copy_id(r->dist, sizeof(r->dist), val);
+  else if (strcmp(key, "threads") == 0)
+    r->threads = atoi(val);
+  else if (strcmp(key, "n") == 0)
+    r->n = atoi(val);
+  else if (strcmp(key, "disorder") == 0)
+    r->disorder = strtod(val, NULL);
+  else if (strcmp(key, "seed") == 0)
+    r->seed = (unsigned int)strtoul(val, NULL, 10);
+  else if (strcmp(key, "warmup") == 0)
+    r->warmup = atoi(val);
+  else if (strcmp(key, "runs") == 0)
+    r->st.runs = atoi(val);
+  else if (strcmp(key, "min_ms") == 0)
+    r->st.min = strtod(val, NULL);
+  else if (strcmp(key, "median_ms") == 0)
+    r->st.median = strtod(val, NULL);
+  else if (strcmp(key, "p95_ms") == 0)
+    r->st.p95 = strtod(val, NULL);
+  else if (strcmp(key, "mean_ms") == 0)
+    r->st.mean = strtod(val, NULL);
+  else if (strcmp(key, "stddev_ms") == 0)
+    r->st.stddev = strtod(val, NULL);
+  else if (strcmp(key, "boxed_median_ms") == 0)
+    r->boxed_ms = strtod(val, NULL);
+  else
+    for (int c = 0; c < PC_COUNT; c++)
+      if (strcmp(key, perf_counter_id(c)) == 0) {
+        r->hw.value[c] = strtoll(val, NULL, 10);
+        r->hw.valid |= 1u << c;
+      }
+}
+
+// Splits line in place at commas; returns the number of fields
+static int split_csv(char *line, char **fields) {
+  line[strcspn(line, "\r\n")] = '\0';
+  int count = 0;
+  for (char *p = line; count < CSV_MAX_COLS;) {
+    fields[count++] = p;
+    p = strchr(p, ',');
+    if (!p)
+      break;
+    *p++ = '\0';
+  }
+  return count;
+}
+
+// One run object per line: "key": value pairs, values are plain strings or
+// numbers. Writes the next pair into key/val and returns the position after
+// it, or NULL at the end of the line.
+static const char *json_pair(const char *p, char *key, char *val,
+                             size_t size) {
+  p = strchr(p, '"');
+  if (!p)
+    return NULL;
+  const char *k_end = strchr(++p, '"');
+  if (!k_end)
+    return NULL;
+  snprintf(key, size, "%.*s", (int)(k_end - p), p);
+  p = k_end + 1;
+  while (*p == ' ' || *p == ':')
+    p++;
+  const char *v_end;
+  if (*p == '"') {
+    v_end = strchr(++p, '"');
+    if (!v_end)
+      return NULL;
+  } else {
+    v_end = p + strcspn(p, ",}\r\n");
+  }
+  snprintf(val, size, "%.*s", (int)(v_end - p), p);
+  return *v_end == '"' ? v_end + 1 : v_end;
+}
+
+static int push_record(BenchRecord **recs, int *count, int *cap,
+                       const BenchRecord *r) {
+  if (*count == *cap) {
+    int new_cap = *cap ? 2 * *cap : 64;
+    BenchRecord *grown = realloc(*recs, new_cap * sizeof(BenchRecord));
+    if (!grown)
+      return -1;
+    *recs = grown;
+    *cap = new_cap;
+  }
+  (*recs)[(*count)++] = *r;
+  return 0;
+}
+
+int bench_results_load(const char *path, BenchRecord **recs) {
+  FILE *f = fopen(path, "r");
+  if (!f)
+    return -1;
+  *recs = NULL;
+  int count = 0, cap = 0, n_cols = 0, json = -1, has_median = 0;
+  char line[LINE_MAX_LEN], header[LINE_MAX_LEN];
+  char *cols[CSV_MAX_COLS], *fields[CSV_MAX_COLS];
+
+  while (fgets(line, sizeof(line), f)) {
+    if (json < 0) {
+      const char *p = line + strspn(line, " \t");
+      if (*p == '\r' || *p == '\n' || *p == '\0')
+        continue;
+      json = *p == '{';
+    }
+    BenchRecord r;
+    record_init(&r);
+    if (json) {
+      if (!strstr(line, "\"algo\""))
+        continue; // Machine object, brackets
+      char key[64], val[64];
+      for (const char *p = line; (p = json_pair(p, key, val, sizeof(key)));)
+        set_field(&r, key, val);
+      has_median = 1;
+    } else {
+      if (line[0] == '#' || line[0] == '\n' || line[0] == '\r')
+        continue;
+      if (n_cols == 0) {
+        strcpy(header, line);
+        n_cols = split_csv(header, cols);
+        for (int c = 0; c < n_cols; c++)
+          has_median |= strcmp(cols[c], "median_ms") == 0;
+        continue;
+      }
+      int n_fields = split_csv(line, fields);
+      for (int c = 0; c < n_fields && c < n_cols; c++)
+        set_field(&r, cols[c], fields[c]);
+    }
+    if (r.algo[0] && r.n > 0 && push_record(recs, &count, &cap, &r) != 0) {
+      free(*recs);
+      *recs = NULL;
+      fclose(f);
+      return -1;
+    }
+  }
+  fclose(f);
+
+  if (!has_median || count == 0) {
+    free(*recs);
+    *recs = NULL;
+    errno = EINVAL;
+    return -1;
+  }
+  return count;
+}
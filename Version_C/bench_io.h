@@ -0,0 +1,57 @@
+#ifndef BENCH_IO_H
+#define BENCH_IO_H
+
+#include "bench.h"
+
+// Benchmark results to and from files, for keeping a run and comparing a
+// later one against it. CSV uses the columns of sort_bench -S (with
+// "# key: value" machine lines on top), so sort_bench output loads as a
+// baseline too; JSON holds the machine object and one run object per line.
+// No GTK dependency.
+
+// One measured point: an algorithm at one size
+typedef struct {
+  char algo[16];    // sort_kernels id
+  char storage[8];  // "typed" or "boxed"
+  int threads;
+  int n;
+  char dist[16];    // bench_dist_id
+  double disorder;  // DIST_NEARLY_SORTED swap fraction, < 0 if unknown
+  unsigned int seed;
+  int warmup;
+  BenchStats st;    // st.runs: timed repetitions
+  double boxed_ms;  // Median on void** storage, < 0 if not measured
+  PerfSample hw;    // valid == 0 without counters
+} BenchRecord;
+
+// Where the results were measured
+typedef struct {
+  char host[64];
+  char cpu[128]; // "model name" of /proc/cpuinfo
+  char os[128];  // uname: system, release, machine
+  int cores;     // Online processors
+  char compiler[64];
+  char date[32]; // Local time, ISO 8601
+} BenchMachine;
+
+void bench_machine_info(BenchMachine *m);
+
+typedef enum {
+  RESULTS_CSV,
+  RESULTS_JSON
+} ResultsFormat;
+
+// JSON for .json names, CSV otherwise
+ResultsFormat bench_results_format_for(const char *path);
+
+// Returns 0, or -1 with errno set
+int bench_results_save(const char *path, ResultsFormat fmt,
+                       const BenchMachine *m, const BenchRecord *recs,
+                       int count);
+
+// Reads a file written by bench_results_save or sort_bench -S (format from
+// the first character). Returns the number of records, stored in a malloc'ed
+// *recs, or -1 with errno set (EINVAL: no median_ms column or run found).
+int bench_results_load(const char *path, BenchRecord **recs);
+
+#endif
@@ -0,0 +1,142 @@
+#include "block_sort.h"
+#include "sort_gen.h"
+
+#define BLOCK 128 // Offsets buffered per side (fit in unsigned char)
+
+#define GT(a, b) ((a) > (b))
+#define LT(a, b) ((a) < (b))
+
+// Introsort supplies median3, the insertion sort of small ranges and the
+// fallback once the depth budget is spent
+DEFINE_INTROSORT(int_asc, int, GT)
+DEFINE_INTROSORT(int_desc, int, LT)
+DEFINE_INTROSORT(double_asc, double, GT)
+DEFINE_INTROSORT(double_desc, double, LT)
+
+#define DEFINE_BLOCK_QUICKSORT(SUFFIX, T, OUT_OF_ORDER)                        \
+  /* Partitions [lo, hi) around the pivot at hi - 1 and returns its final      \
+     index: [lo, p) before the pivot, (p, hi) not before it */                 \
+  static int block_partition_##SUFFIX(T *arr, int lo, int hi) {                \
+    int last = hi - 1;                                                         \
+    T pivot = arr[last];                                                       \
+    unsigned char off_l[BLOCK], off_r[BLOCK];                                  \
+    int l = lo, r = last - 1;                                                  \
+    int num_l = 0, num_r = 0, start_l = 0, start_r = 0;                        \
+    while (r - l + 1 > 2 * BLOCK) {                                            \
+      /* Offsets of the elements to move, counted without branching */         \
+      if (num_l == 0) {                                                        \
+        start_l = 0;                                                           \
+        for (int i = 0; i < BLOCK; i++) {                                      \
+          off_l[num_l] = (unsigned char)i;                                     \
+          num_l += !OUT_OF_ORDER(pivot, arr[l + i]);                           \
+        }                                                                      \
+      }                                                                        \
+      if (num_r == 0) {                                                        \
+        start_r = 0;                                                           \
+        for (int i = 0; i < BLOCK; i++) {                                      \
+          off_r[num_r] = (unsigned char)i;                                     \
+          num_r += OUT_OF_ORDER(pivot, arr[r - i]);                            \
+        }                                                                      \
+      }                                                                        \
+      int num = num_l < num_r ? num_l : num_r;                                 \
+      for (int j = 0; j < num; j++) {                                          \
+        int a = l + off_l[start_l + j], b = r - off_r[start_r + j];            \
+        T t = arr[a];                                                          \
+        arr[a] = arr[b];                                                       \
+        arr[b] = t;                                                            \
+      }                                                                        \
+      num_l -= num;                                                            \
+      num_r -= num;                                                            \
+      start_l += num;                                                          \
+      start_r += num;                                                          \
+      if (num_l == 0)                                                          \
+        l += BLOCK;                                                            \
+      if (num_r == 0)                                                          \
+        r -= BLOCK;                                                            \
+    }                                                                          \
+    /* Rest, including a partly processed block: branchless Lomuto (every      \
+       element is swapped, the boundary moves by the comparison result) */     \
+    int i = l;                                                                 \
+    for (int j = l; j <= r; j++) {                                             \
+      T t = arr[j];                                                            \
+      int before = OUT_OF_ORDER(pivot, t);                                     \
+      arr[j] = arr[i];                                                         \
+      arr[i] = t;                                                              \
+      i += before;                                                             \
+    }                                                                          \
+    arr[last] = arr[i];                                                        \
+    arr[i] = pivot;                                                            \
+    return i;                                                                  \
+  }                                                                            \
+  /* arr[lo - 1], when lo > 0, is not after any element of [lo, hi) */         \
+  static void block_loop_##SUFFIX(T *arr, int lo, int hi, int depth) {         \
+    while (hi - lo > INTRO_CUTOFF) {                                           \
+      if (depth-- == 0) {                                                      \
+        introsort_##SUFFIX(arr + lo, hi - lo);                                 \
+        return;                                                                \
+      }                                                                        \
+      int n = hi - lo, mid = lo + n / 2, m;                                    \
+      if (n >= INTRO_NINTHER_MIN) {                                            \
+        int s = n / 8;                                                         \
+        m = median3_##SUFFIX(                                                  \
+            arr, median3_##SUFFIX(arr, lo, lo + s, lo + 2 * s),                \
+            median3_##SUFFIX(arr, mid - s, mid, mid + s),                      \
+            median3_##SUFFIX(arr, hi - 1 - 2 * s, hi - 1 - s, hi - 1));        \
+      } else {                                                                 \
+        m = median3_##SUFFIX(arr, lo, mid, hi - 1);                            \
+      }                                                                        \
+      T pivot = arr[m];                                                        \
+      arr[m] = arr[hi - 1];                                                    \
+      arr[hi - 1] = pivot;                                                     \
+                                                                               \
+      /* Pivot equal to the previous one: it is the minimum of the range,      \
+         so its duplicates go left and are already in place */                 \
+      if (lo > 0 && !OUT_OF_ORDER(pivot, arr[lo - 1])) {                       \
+        int i = lo;                                                            \
+        for (int j = lo; j < hi; j++) {                                        \
+          T t = arr[j];                                                        \
+          int dup = !OUT_OF_ORDER(t, pivot);                                   \
+          arr[j] = arr[i];                                                     \
+          arr[i] = t;                                                          \
+          i += dup;                                                            \
+        }                                                                      \
+        lo = i;                                                                \
+        continue;                                                              \
+      }                                                                        \
+                                                                               \
+      int p = block_partition_##SUFFIX(arr, lo, hi);                           \
+      if (p - lo < hi - p - 1) {                                               \
+        block_loop_##SUFFIX(arr, lo, p, depth);                                \
+        lo = p + 1;                                                            \
+      } else {                                                                 \
+        block_loop_##SUFFIX(arr, p + 1, hi, depth);                            \
+        hi = p;                                                                \
+      }                                                                        \
+    }                                                                          \
+    intro_insertion_##SUFFIX(arr + lo, hi - lo);                               \
+  }                                                                            \
+  static void block_quicksort_##SUFFIX(T *arr, int n) {                        \
+    int depth = 0;                                                             \
+    for (int k = n; k > 1; k >>= 1)                                            \
+      depth += 2;                                                              \
+    block_loop_##SUFFIX(arr, 0, n, depth);                                     \
+  }
+
+DEFINE_BLOCK_QUICKSORT(int_asc, int, GT)
+DEFINE_BLOCK_QUICKSORT(int_desc, int, LT)
+DEFINE_BLOCK_QUICKSORT(double_asc, double, GT)
+DEFINE_BLOCK_QUICKSORT(double_desc, double, LT)
+
+void block_sort_int(int *arr, int n, int descending) {
+  if (descending)
+    block_quicksort_int_desc(arr, n);
+  else
+    block_quicksort_int_asc(arr, n);
+}
+
+void block_sort_double(double *arr, int n, int descending) {
+  if (descending)
+    block_quicksort_double_desc(arr, n);
+  else
+    block_quicksort_double_asc(arr, n);
+}
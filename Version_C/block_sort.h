@@ -0,0 +1,14 @@
+#ifndef BLOCK_SORT_H
+#define BLOCK_SORT_H
+
+// BlockQuicksort (Edelkamp & Weiss) for ints and doubles. Partitioning
+// compares a block of elements per side against the pivot and only records
+// the offsets of misplaced ones, then swaps them pairwise: no branch depends
+// on the comparisons, so random data does not cost branch misses. Pivots
+// equal to the previous one put their duplicates aside (pdqsort), and the
+// depth budget falls back to Introsort. No GTK dependency.
+
+void block_sort_int(int *arr, int n, int descending);
+void block_sort_double(double *arr, int n, int descending);
+
+#endif
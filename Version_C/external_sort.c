@@ -0,0 +1,296 @@
+#include "external_sort.h"
+#include "bench.h"
+#include <errno.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+// --- Run Files ---
+
+// Anonymous temporary file: unlinked right away, gone when closed
+static FILE *open_run(const char *tmp_dir) {
+  char path[4096];
+  snprintf(path, sizeof(path), "%s/sortrunXXXXXX", tmp_dir);
+  int fd = mkstemp(path);
+  if (fd < 0)
+    return NULL;
+  unlink(path);
+  FILE *f = fdopen(fd, "w+b");
+  if (!f)
+    close(fd);
+  return f;
+}
+
+static void close_runs(FILE **runs, int count) {
+  for (int i = 0; i < count; i++)
+    if (runs[i])
+      fclose(runs[i]);
+}
+
+// --- K-way Merge ---
+
+typedef struct {
+  FILE *f;
+  char *buf;
+  size_t cap; // Elements per block
+  size_t len;
+  size_t pos;
+  int done;
+} RunReader;
+
+static int reader_refill(RunReader *r, size_t elem) {
+  r->len = fread(r->buf, elem, r->cap, r->f);
+  r->pos = 0;
+  r->done = r->len == 0;
+  return ferror(r->f) ? -1 : 0;
+}
+
+// Loser tree over k runs: tree[0] holds the winner (next element to write),
+// tree[1..k-1] the loser of each internal node. Exhausted runs lose to
+// everything, so the merge ends when the winner is exhausted.
+#define DEFINE_MERGE(SUFFIX, T, OUT_OF_ORDER)                                  \
+  static int beats_##SUFFIX(const RunReader *r, int a, int b) {                \
+    if (r[b].done)                                                             \
+      return 1;                                                                \
+    if (r[a].done)                                                             \
+      return 0;                                                                \
+    return !OUT_OF_ORDER(((T *)r[a].buf)[r[a].pos],                            \
+                         ((T *)r[b].buf)[r[b].pos]);                           \
+  }                                                                            \
+  static int merge_##SUFFIX(RunReader *r, int k, FILE *out, T *obuf,           \
+                            size_t ocap, long long *count) {                   \
+    int tree[EXT_MAX_FANIN];                                                   \
+    for (int i = 0; i < k; i++)                                                \
+      tree[i] = -1;                                                            \
+    for (int i = k - 1; i >= 0; i--) {                                         \
+      int w = i;                                                               \
+      for (int p = (i + k) / 2; p > 0; p /= 2) {                               \
+        if (tree[p] < 0) {                                                     \
+          tree[p] = w;                                                         \
+          w = -1;                                                              \
+          break;                                                               \
+        }                                                                      \
+        if (beats_##SUFFIX(r, tree[p], w)) {                                   \
+          int t = tree[p];                                                     \
+          tree[p] = w;                                                         \
+          w = t;                                                               \
+        }                                                                      \
+      }                                                                        \
+      if (w >= 0)                                                              \
+        tree[0] = w;                                                           \
+    }                                                                          \
+    size_t olen = 0;                                                           \
+    for (;;) {                                                                 \
+      int w = tree[0];                                                         \
+      if (r[w].done)                                                           \
+        break;                                                                 \
+      obuf[olen++] = ((T *)r[w].buf)[r[w].pos++];                              \
+      if (olen == ocap) {                                                      \
+        if (fwrite(obuf, sizeof(T), olen, out) != olen)                        \
+          return -1;                                                           \
+        *count += olen;                                                        \
+        olen = 0;                                                              \
+      }                                                                        \
+      if (r[w].pos == r[w].len && reader_refill(&r[w], sizeof(T)) < 0)         \
+        return -1;                                                             \
+      for (int p = (w + k) / 2; p > 0; p /= 2)                                 \
+        if (beats_##SUFFIX(r, tree[p], w)) {                                   \
+          int t = tree[p];                                                     \
+          tree[p] = w;                                                         \
+          w = t;                                                               \
+        }                                                                      \
+      tree[0] = w;                                                             \
+    }                                                                          \
+    if (olen && fwrite(obuf, sizeof(T), olen, out) != olen)                    \
+      return -1;                                                               \
+    *count += olen;                                                            \
+    return 0;                                                                  \
+  }
+
+#define GT(a, b) ((a) > (b))
+#define LT(a, b) ((a) < (b))
+DEFINE_MERGE(int_asc, int, GT)
+DEFINE_MERGE(int_desc, int, LT)
+DEFINE_MERGE(double_asc, double, GT)
+DEFINE_MERGE(double_desc, double, LT)
+
+// Smallest block worth a read: below this the merge is seek-bound
+#define MERGE_MIN_BLOCK 4096
+
+// Widest merge whose k inputs + output still get MERGE_MIN_BLOCK elements
+// each out of mem_bytes; a smaller budget means more passes, not more memory
+static int merge_fanin(size_t mem_bytes, size_t elem) {
+  size_t k = mem_bytes / (MERGE_MIN_BLOCK * elem) - 1;
+  if (k > EXT_MAX_FANIN)
+    k = EXT_MAX_FANIN;
+  return k < 2 ? 2 : (int)k;
+}
+
+// Merges runs[0..k) into out with mem_bytes of buffers
+static int merge_runs(FILE **runs, int k, FILE *out, DataType type, int desc,
+                      size_t mem_bytes, long long *count) {
+  size_t elem = type == TYPE_INT ? sizeof(int) : sizeof(double);
+  size_t block = mem_bytes / (k + 1) / elem; // k inputs + the output
+
+  RunReader *r = calloc(k, sizeof(RunReader));
+  if (!r)
+    return -1;
+  void *obuf = malloc(block * elem);
+  int rc = obuf ? 0 : -1;
+  for (int i = 0; i < k && rc == 0; i++) {
+    r[i].f = runs[i];
+    r[i].cap = block;
+    r[i].buf = malloc(block * elem);
+    if (!r[i].buf || fseek(runs[i], 0, SEEK_SET) != 0 ||
+        reader_refill(&r[i], elem) < 0)
+      rc = -1;
+  }
+
+  if (rc == 0) {
+    if (type == TYPE_INT)
+      rc = desc ? merge_int_desc(r, k, out, obuf, block, count)
+                : merge_int_asc(r, k, out, obuf, block, count);
+    else
+      rc = desc ? merge_double_desc(r, k, out, obuf, block, count)
+                : merge_double_asc(r, k, out, obuf, block, count);
+  }
+
+  for (int i = 0; i < k; i++)
+    free(r[i].buf);
+  free(r);
+  free(obuf);
+  return rc;
+}
+
+// --- Driver ---
+
+int external_sort_file(const char *in_path, const char *out_path,
+                       DataType type, int algo, int descending,
+                       size_t mem_bytes, const char *tmp_dir,
+                       ExtSortStats *st) {
+  memset(st, 0, sizeof(*st));
+  if (type != TYPE_INT && type != TYPE_DOUBLE) {
+    errno = EINVAL;
+    return -1;
+  }
+  if (!tmp_dir)
+    tmp_dir = getenv("TMPDIR") ? getenv("TMPDIR") : "/tmp";
+  if (mem_bytes < EXT_MIN_MEM)
+    mem_bytes = EXT_MIN_MEM;
+
+  size_t elem = type == TYPE_INT ? sizeof(int) : sizeof(double);
+  size_t chunk = mem_bytes / elem;
+  if (chunk > 0x7fffffff)
+    chunk = 0x7fffffff; // TypedArray counts in int
+
+  double t0 = bench_now_ms();
+  FILE *in = fopen(in_path, "rb");
+  if (!in)
+    return -1;
+  FILE *out = NULL;
+  FILE **runs = NULL;
+  int n_runs = 0, cap_runs = 0;
+  void *buf = malloc(chunk * elem);
+  int rc = buf ? 0 : -1;
+
+  // Phase 1: sorted runs of one chunk each
+  while (rc == 0) {
+    double t = bench_now_ms();
+    size_t got = fread(buf, elem, chunk, in);
+    st->read_ms += bench_now_ms() - t;
+    if (ferror(in)) {
+      rc = -1;
+      break;
+    }
+    if (got == 0)
+      break;
+
+    t = bench_now_ms();
+    TypedArray ta = {.type = type, .n = (int)got};
+    if (type == TYPE_INT)
+      ta.ints = buf;
+    else
+      ta.doubles = buf;
+    typed_sort(&ta, algo, descending);
+    st->sort_ms += bench_now_ms() - t;
+
+    // A single chunk holding the whole file goes straight to the output
+    t = bench_now_ms();
+    FILE *dst;
+    if (n_runs == 0 && got < chunk) {
+      dst = out = fopen(out_path, "wb");
+    } else {
+      if (n_runs == cap_runs) {
+        int cap = cap_runs ? 2 * cap_runs : 16;
+        FILE **grown = realloc(runs, cap * sizeof(FILE *));
+        if (!grown) { // The runs already written are closed below
+          rc = -1;
+          break;
+        }
+        runs = grown;
+        cap_runs = cap;
+      }
+      dst = runs[n_runs++] = open_run(tmp_dir);
+    }
+    if (!dst || fwrite(buf, elem, got, dst) != got)
+      rc = -1;
+    st->write_ms += bench_now_ms() - t;
+    st->count += got;
+    if (got < chunk)
+      break;
+  }
+  free(buf);
+  fclose(in);
+  st->runs = out ? 1 : n_runs;
+
+  // Phase 2: merge passes of at most fanin runs
+  int fanin = merge_fanin(mem_bytes, elem);
+  double t = bench_now_ms();
+  while (rc == 0 && !out && n_runs > 0) {
+    if (n_runs <= fanin) {
+      out = fopen(out_path, "wb");
+      long long count = 0;
+      rc = out ? merge_runs(runs, n_runs, out, type, descending, mem_bytes,
+                            &count)
+               : -1;
+      st->passes++;
+      break;
+    }
+    int merged = 0, i;
+    for (i = 0; i < n_runs && rc == 0; i += fanin) {
+      int k = n_runs - i < fanin ? n_runs - i : fanin;
+      FILE *dst = open_run(tmp_dir);
+      long long count = 0;
+      rc = dst ? merge_runs(runs + i, k, dst, type, descending, mem_bytes,
+                            &count)
+               : -1;
+      close_runs(runs + i, k);
+      for (int j = 0; j < k; j++)
+        runs[i + j] = NULL;
+      runs[merged++] = dst;
+    }
+    if (i < n_runs) // Stopped on an error: the later groups are still open
+      close_runs(runs + i, n_runs - i);
+    n_runs = merged;
+    st->passes++;
+  }
+  st->merge_ms = bench_now_ms() - t;
+
+  int saved = errno;
+  close_runs(runs, n_runs);
+  free(runs);
+  if (out && fclose(out) != 0 && rc == 0) {
+    rc = -1;
+    saved = errno;
+  }
+  if (!out && rc == 0) {
+    // Empty input: still produce an empty output file
+    out = fopen(out_path, "wb");
+    if (!out || fclose(out) != 0)
+      rc = -1;
+  }
+  errno = saved;
+  st->total_ms = bench_now_ms() - t0;
+  return rc;
+}
@@ -0,0 +1,37 @@
+#ifndef EXTERNAL_SORT_H
+#define EXTERNAL_SORT_H
+
+#include "typed_sort.h"
+#include <stddef.h>
+
+// External merge sort of raw binary files (native int or double array,
+// no header) larger than RAM. Chunks of mem_bytes are read sequentially,
+// sorted in memory with typed_sort (same algorithm selector as the view) and
+// spilled to temporary run files, then merged k ways with a loser tree.
+// The merge width is capped by EXT_MAX_FANIN and by mem_bytes (every input
+// block keeps at least 4096 elements), extra runs take extra passes, so
+// buffers never exceed mem_bytes. No GTK dependency.
+
+#define EXT_MAX_FANIN 256
+#define EXT_MIN_MEM (1 << 20)
+
+typedef struct {
+  long long count; // Elements sorted
+  int runs;        // Runs written by the first phase
+  int passes;      // Merge passes (0 when everything fit in one chunk)
+  double read_ms;  // Phase 1: reading the chunks
+  double sort_ms;  // Phase 1: sorting them in memory
+  double write_ms; // Phase 1: writing the runs
+  double merge_ms; // Phase 2: every merge pass, output included
+  double total_ms;
+} ExtSortStats;
+
+// type is TYPE_INT or TYPE_DOUBLE; algo is a SortAlgo. Temporary files go
+// to tmp_dir (NULL: $TMPDIR or /tmp) and are unlinked as soon as they are
+// created. Returns 0 on success, -1 with errno set otherwise.
+int external_sort_file(const char *in_path, const char *out_path,
+                       DataType type, int algo, int descending,
+                       size_t mem_bytes, const char *tmp_dir,
+                       ExtSortStats *st);
+
+#endif
@@ -1,4 +1,5 @@
 #include "app.h"
+#include "rng.h"
 #include <ctype.h>
 #include <float.h>
 #include <limits.h>
@@ -44,6 +45,7 @@ static int path_len = 0;
 
 // UI
 static GtkWidget *entry_count;
+static GtkWidget *spin_seed; // Generation seed, 0 draws a new one
 static GtkWidget *combo_dtype;
 static GtkWidget *combo_graph_type; // GO or GNO
 static GtkWidget *combo_algo;
@@ -115,6 +117,10 @@ static void generate_graph() {
   double r = (w < h ? w : h) / 2.0 - 50;
 
   int type_idx = gtk_drop_down_get_selected(GTK_DROP_DOWN(combo_dtype));
+  unsigned int seed = rng_seed_or_fresh(
+      (unsigned int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(spin_seed)));
+  Rng rng;
+  rng_seed(&rng, seed);
   // 0=Int, 1=Double, 2=Char, 3=String (Matching Python UI order approx)
 
   for (int i = 0; i < n; i++) {
@@ -124,16 +130,16 @@ static void generate_graph() {
     nodes[i].y = cy + r * sin(angle);
 
     if (type_idx == 0)
-      sprintf(nodes[i].label, "%d", rand() % 100);
+      sprintf(nodes[i].label, "%d", (int)rng_below(&rng, 100));
     else if (type_idx == 1)
-      sprintf(nodes[i].label, "%.1f", (rand() % 1000) / 10.0);
+      sprintf(nodes[i].label, "%.1f", rng_below(&rng, 1000) / 10.0);
     else if (type_idx == 2)
       sprintf(nodes[i].label, "%c", 'A' + i);
     else
       sprintf(nodes[i].label, "S%d", i);
   }
   node_count = n;
-  log_msg_graph("Genere %d noeuds (sans liens).", n);
+  log_msg_graph("Genere %d noeuds (sans liens, graine %u).", n, seed);
   gtk_widget_queue_draw(drawing_area);
 }
 
@@ -679,6 +685,11 @@ GtkWidget *create_graph_view(AppContext *ctx) {
   gtk_editable_set_text(GTK_EDITABLE(entry_count), "5");
   gtk_box_append(GTK_BOX(b1), entry_count);
 
+  // Seed of random labels, 0 = a new one each time
+  gtk_box_append(GTK_BOX(b1), gtk_label_new("Graine (0 = nouvelle):"));
+  spin_seed = gtk_spin_button_new_with_range(0, 4294967295.0, 1);
+  gtk_box_append(GTK_BOX(b1), spin_seed);
+
   gtk_box_append(GTK_BOX(b1), gtk_label_new("Type de Donnee:"));
   const char *dtypes[] = {"Entiers", "Reels", "Caracteres", "Strings", NULL};
   combo_dtype = gtk_drop_down_new_from_strings(dtypes);
@@ -1,4 +1,5 @@
 #include "app.h"
+#include "rng.h"
 #include <ctype.h>
 #include <string.h>
 
@@ -36,8 +37,10 @@ typedef struct {
   int target_count;
   int current_count;
   guint timer_id;
+  unsigned int seed; // One seed per generated list
+  Rng rng;
 } GenState;
-static GenState gen_state = {0, 0, 0};
+static GenState gen_state = {0, 0, 0, 0, {{0, 0, 0, 0}}};
 
 // UI Controls
 static GtkWidget *combo_ltype;
@@ -51,6 +54,7 @@ static GtkWidget *entry_pos;
 static GtkWidget *drawing_area;
 static GtkWidget *text_log;
 static GtkWidget *label_res_count;
+static GtkWidget *spin_seed; // Generation seed, 0 draws a new one
 
 // Forward Declarations
 static void update_drawing_area_size();
@@ -508,10 +512,14 @@ static void on_size_dialog_ok(GtkButton *btn, gpointer user_data) {
 
   gen_state.target_count = n;
   gen_state.current_count = 0;
+  gen_state.seed = rng_seed_or_fresh(
+      (unsigned int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(spin_seed)));
+  rng_seed(&gen_state.rng, gen_state.seed);
   gen_state.timer_id =
       g_timeout_add(100, generation_tick, NULL); // 100ms per node
 
-  log_msg("Demarrage generation: %d elements...", n);
+  log_msg("Demarrage generation: %d elements (graine %u)...", n,
+          gen_state.seed);
 }
 
 static void on_gen(GtkButton *btn, gpointer data) {
@@ -673,17 +681,17 @@ static gboolean generation_tick(gpointer user_data) {
   // Add one node
   if (current_dtype == TYPE_INT) {
     int *v = malloc(sizeof(int));
-    *v = rand() % 100;
+    *v = (int)rng_below(&gen_state.rng, 100);
     append_node(v);
   } else if (current_dtype == TYPE_DOUBLE) {
     double *v = malloc(sizeof(double));
-    *v = (double)(rand() % 1000) / 10.0;
+    *v = rng_below(&gen_state.rng, 1000) / 10.0;
     append_node(v);
   } else if (current_dtype == TYPE_STRING) {
     append_node(strdup("RND"));
   } else {
     char *v = malloc(sizeof(char));
-    *v = 'A' + rand() % 26;
+    *v = 'A' + rng_below(&gen_state.rng, 26);
     append_node(v);
   }
 
@@ -1027,6 +1035,12 @@ GtkWidget *create_list_view(AppContext *ctx) {
   gtk_box_append(GTK_BOX(box_rad), radio_manual);
   gtk_grid_attach(GTK_GRID(g1), box_rad, 1, 3, 1, 1);
 
+  // Seed of random lists, 0 = a new one each time
+  gtk_grid_attach(GTK_GRID(g1), gtk_label_new("Graine (0 = nouvelle):"), 0, 4,
+                  1, 1);
+  spin_seed = gtk_spin_button_new_with_range(0, 4294967295.0, 1);
+  gtk_grid_attach(GTK_GRID(g1), spin_seed, 1, 4, 1, 1);
+
   // Manual Entry (Initially hidden)
   entry_manual = gtk_entry_new();
   gtk_editable_set_text(GTK_EDITABLE(entry_manual), "10,20,30");
@@ -42,8 +42,6 @@ int main(int argc, char **argv) {
   GtkApplication *app;
   int status;
 
-  srand(time(NULL)); // Init Random
-
   app = gtk_application_new("com.example.visualizer", G_APPLICATION_FLAGS_NONE);
   g_signal_connect(app, "activate", G_CALLBACK(activate), NULL);
   status = g_application_run(G_APPLICATION(app), argc, argv);
@@ -0,0 +1,27 @@
+#include "op_count.h"
+#include "sort.h"
+#include <string.h>
+
+static SortOps ops;
+
+#define SORT_OP_SWAP() (ops.swaps++)
+#define SORT_OP_MOVE() (ops.moves++)
+#define SORT_OP_MOVES(k) (ops.moves += (k))
+#include "sort_gen.h"
+
+#define COUNT_GT(a, b) (ops.cmp++, (a) > (b))
+DEFINE_SORTS(count, int, COUNT_GT)
+
+#ifdef SORT_COUNT_OPS
+SortOps sort_ops_generic;
+#endif
+
+int sort_ops_supported(int algo) { return sort_is_comparison(algo); }
+
+void sort_count_ops(int algo, const int *input, int *work, int n,
+                    SortOps *out) {
+  memcpy(work, input, n * sizeof(int));
+  memset(&ops, 0, sizeof(ops));
+  sort_count(work, n, algo);
+  *out = ops;
+}
@@ -0,0 +1,31 @@
+#ifndef OP_COUNT_H
+#define OP_COUNT_H
+
+// Operation counts of the comparison sorts: a second instantiation of the
+// sort_gen.h kernels with the SORT_OP_* hooks and a counting comparator.
+// The timed kernels are separate copies with the hooks compiled out, so
+// counting never shows up in a measured time. No GTK dependency.
+
+typedef struct {
+  long long cmp;   // Element comparisons
+  long long swaps; // Exchanges of two elements
+  long long moves; // Single-element writes (insertion/shell shifts)
+} SortOps;
+
+int sort_ops_supported(int algo); // sort_is_comparison (sort.h)
+
+// Copies input into work and sorts it ascending with the counting kernel.
+// Not reentrant: one counting run at a time.
+void sort_count_ops(int algo, const int *input, int *work, int n,
+                    SortOps *out);
+
+// The cmp_generic reference sorts of the sorting view count into
+// sort_ops_generic only in builds with -DSORT_COUNT_OPS.
+#ifdef SORT_COUNT_OPS
+extern SortOps sort_ops_generic;
+#define GENERIC_OP(field) (sort_ops_generic.field++)
+#else
+#define GENERIC_OP(field) ((void)0)
+#endif
+
+#endif
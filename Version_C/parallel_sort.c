@@ -0,0 +1,233 @@
+#include "parallel_sort.h"
+#include "sort_gen.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#define PAR_CUTOFF 8192
+#define DEQUE_CAP 256
+
+// --- Work-Stealing Pool ---
+
+typedef struct {
+  int lo, hi;
+  int depth;
+} Task;
+
+// The owner pushes/pops at the bottom, thieves take the oldest (largest)
+// task from the top. A mutex per deque is enough at this task granularity.
+typedef struct {
+  pthread_mutex_t lock;
+  Task items[DEQUE_CAP];
+  int top, bottom;
+} Deque;
+
+typedef struct Pool Pool;
+typedef void (*TaskFunc)(Pool *pool, int self, Task task);
+
+struct Pool {
+  void *arr;
+  TaskFunc run;
+  int threads;
+  atomic_int pending; // Tasks pushed and not finished yet
+  Deque deques[PAR_MAX_THREADS];
+};
+
+typedef struct {
+  Pool *pool;
+  int self;
+} WorkerArg;
+
+static int par_threads = 0;
+
+int parallel_default_threads(void) {
+  long cpus = sysconf(_SC_NPROCESSORS_ONLN);
+  if (cpus < 1)
+    cpus = 1;
+  return cpus > PAR_MAX_THREADS ? PAR_MAX_THREADS : (int)cpus;
+}
+
+void parallel_set_threads(int threads) {
+  if (threads > PAR_MAX_THREADS)
+    threads = PAR_MAX_THREADS;
+  par_threads = threads;
+}
+
+int parallel_get_threads(void) {
+  return par_threads > 0 ? par_threads : parallel_default_threads();
+}
+
+// Returns 0 when the deque is full: the caller then runs the task itself
+static int pool_push(Pool *pool, int self, Task task) {
+  Deque *d = &pool->deques[self];
+  int ok = 0;
+  pthread_mutex_lock(&d->lock);
+  if (d->bottom < DEQUE_CAP) {
+    atomic_fetch_add(&pool->pending, 1);
+    d->items[d->bottom++] = task;
+    ok = 1;
+  }
+  pthread_mutex_unlock(&d->lock);
+  return ok;
+}
+
+static int pool_pop(Pool *pool, int self, Task *task) {
+  Deque *d = &pool->deques[self];
+  int ok = 0;
+  pthread_mutex_lock(&d->lock);
+  if (d->bottom > d->top) {
+    *task = d->items[--d->bottom];
+    ok = 1;
+  }
+  if (d->bottom == d->top)
+    d->top = d->bottom = 0;
+  pthread_mutex_unlock(&d->lock);
+  return ok;
+}
+
+static int pool_steal(Pool *pool, int self, Task *task) {
+  for (int k = 1; k < pool->threads; k++) {
+    Deque *d = &pool->deques[(self + k) % pool->threads];
+    int ok = 0;
+    pthread_mutex_lock(&d->lock);
+    if (d->bottom > d->top) {
+      *task = d->items[d->top++];
+      ok = 1;
+    }
+    pthread_mutex_unlock(&d->lock);
+    if (ok)
+      return 1;
+  }
+  return 0;
+}
+
+static void *pool_worker(void *data) {
+  WorkerArg *w = data;
+  Pool *pool = w->pool;
+  Task task;
+  while (atomic_load(&pool->pending) > 0) {
+    if (pool_pop(pool, w->self, &task) || pool_steal(pool, w->self, &task)) {
+      pool->run(pool, w->self, task);
+      atomic_fetch_sub(&pool->pending, 1);
+    } else {
+      sched_yield();
+    }
+  }
+  return NULL;
+}
+
+// Runs the task [0, n) on `threads` workers; the caller is worker 0.
+// Workers that cannot be started leave their deque empty and the others
+// share the work; returns 0 without a pool, for the caller to sort alone.
+static int pool_run(void *arr, int n, TaskFunc run, int threads) {
+  Pool *pool = calloc(1, sizeof(Pool));
+  if (!pool)
+    return 0;
+  pool->arr = arr;
+  pool->run = run;
+  pool->threads = threads;
+  for (int t = 0; t < threads; t++)
+    pthread_mutex_init(&pool->deques[t].lock, NULL);
+
+  int depth = 0;
+  for (int k = n; k > 1; k >>= 1)
+    depth += 2;
+  pool_push(pool, 0, (Task){0, n, depth});
+
+  pthread_t tids[PAR_MAX_THREADS];
+  int started[PAR_MAX_THREADS] = {0};
+  WorkerArg args[PAR_MAX_THREADS];
+  for (int t = 0; t < threads; t++)
+    args[t] = (WorkerArg){pool, t};
+  for (int t = 1; t < threads; t++)
+    started[t] = pthread_create(&tids[t], NULL, pool_worker, &args[t]) == 0;
+  pool_worker(&args[0]);
+  for (int t = 1; t < threads; t++)
+    if (started[t])
+      pthread_join(tids[t], NULL);
+
+  for (int t = 0; t < threads; t++)
+    pthread_mutex_destroy(&pool->deques[t].lock);
+  free(pool);
+  return 1;
+}
+
+// --- Parallel Quicksort ---
+
+// Partitions with the introsort pivot/three-way scheme, hands the left side
+// to the pool and keeps going on the right. Leaves and exhausted depth go
+// to the sequential introsort.
+#define DEFINE_PARALLEL_QUICK(SUFFIX, T, OUT_OF_ORDER)                         \
+  DEFINE_INTROSORT(SUFFIX, T, OUT_OF_ORDER)                                    \
+  static void par_task_##SUFFIX(Pool *pool, int self, Task task) {             \
+    T *arr = pool->arr;                                                        \
+    int lo = task.lo, hi = task.hi, depth = task.depth;                        \
+    while (hi - lo > PAR_CUTOFF && depth-- > 0) {                              \
+      int lt, gt;                                                              \
+      partition3_##SUFFIX(arr, lo, hi, &lt, &gt);                              \
+      Task left = {lo, lt, depth};                                             \
+      if (!pool_push(pool, self, left))                                        \
+        introsort_##SUFFIX(arr + lo, lt - lo);                                 \
+      lo = gt + 1;                                                             \
+    }                                                                          \
+    introsort_##SUFFIX(arr + lo, hi - lo);                                     \
+  }                                                                            \
+  static void par_sort_##SUFFIX(T *arr, int n, int threads) {                  \
+    if (threads <= 1 || n <= PAR_CUTOFF ||                                     \
+        !pool_run(arr, n, par_task_##SUFFIX, threads))                         \
+      introsort_##SUFFIX(arr, n);                                              \
+  }
+
+#define GT(a, b) ((a) > (b))
+#define LT(a, b) ((a) < (b))
+#define STR_GT(a, b) (strcmp((a), (b)) > 0)
+#define STR_LT(a, b) (strcmp((a), (b)) < 0)
+
+DEFINE_PARALLEL_QUICK(int_asc, int, GT)
+DEFINE_PARALLEL_QUICK(int_desc, int, LT)
+DEFINE_PARALLEL_QUICK(double_asc, double, GT)
+DEFINE_PARALLEL_QUICK(double_desc, double, LT)
+DEFINE_PARALLEL_QUICK(char_asc, char, GT)
+DEFINE_PARALLEL_QUICK(char_desc, char, LT)
+DEFINE_PARALLEL_QUICK(str_asc, char *, STR_GT)
+DEFINE_PARALLEL_QUICK(str_desc, char *, STR_LT)
+
+void parallel_sort_int(int *arr, int n, int descending, int threads) {
+  if (threads <= 0)
+    threads = parallel_get_threads();
+  if (descending)
+    par_sort_int_desc(arr, n, threads);
+  else
+    par_sort_int_asc(arr, n, threads);
+}
+
+void parallel_sort_typed(TypedArray *ta, int descending, int threads) {
+  if (threads <= 0)
+    threads = parallel_get_threads();
+  switch (ta->type) {
+  case TYPE_INT:
+    parallel_sort_int(ta->ints, ta->n, descending, threads);
+    break;
+  case TYPE_DOUBLE:
+    if (descending)
+      par_sort_double_desc(ta->doubles, ta->n, threads);
+    else
+      par_sort_double_asc(ta->doubles, ta->n, threads);
+    break;
+  case TYPE_CHAR:
+    if (descending)
+      par_sort_char_desc(ta->chars, ta->n, threads);
+    else
+      par_sort_char_asc(ta->chars, ta->n, threads);
+    break;
+  case TYPE_STRING:
+    if (descending)
+      par_sort_str_desc(ta->strs, ta->n, threads);
+    else
+      par_sort_str_asc(ta->strs, ta->n, threads);
+    break;
+  }
+}
@@ -0,0 +1,21 @@
+#ifndef PARALLEL_SORT_H
+#define PARALLEL_SORT_H
+
+#include "typed_sort.h"
+
+// Parallel quicksort on a small work-stealing pool (pthreads). Ranges above
+// PAR_CUTOFF are partitioned and one side is pushed to the worker's deque,
+// where idle workers steal it; smaller ranges use the sequential introsort.
+// No GTK dependency.
+
+#define PAR_MAX_THREADS 64
+
+int parallel_default_threads(void); // Online CPUs, clamped to the max
+void parallel_set_threads(int threads);
+int parallel_get_threads(void);
+
+// threads <= 0 uses the value of parallel_set_threads()
+void parallel_sort_int(int *arr, int n, int descending, int threads);
+void parallel_sort_typed(TypedArray *ta, int descending, int threads);
+
+#endif
@@ -0,0 +1,113 @@
+#define _GNU_SOURCE // syscall()
+#include "perf_counters.h"
+#include <string.h>
+
+static const char *counter_ids[PC_COUNT] = {
+    "cycles", "instructions", "branch_misses",
+    "l1d_misses", "llc_misses", "dtlb_misses"};
+static const char *counter_names[PC_COUNT] = {
+    "Cycles", "Instructions", "Branches ratees",
+    "Defauts L1d", "Defauts LLC", "Defauts dTLB"};
+
+const char *perf_counter_id(PerfCounterId id) { return counter_ids[id]; }
+
+const char *perf_counter_name(PerfCounterId id) { return counter_names[id]; }
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#define CACHE_READ_MISS(cache)                                                 \
+  ((cache) | (PERF_COUNT_HW_CACHE_OP_READ << 8) |                              \
+   (PERF_COUNT_HW_CACHE_RESULT_MISS << 16))
+
+static const struct {
+  unsigned int type;
+  unsigned long long config;
+} events[PC_COUNT] = {
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+    {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES},
+    {PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_L1D)},
+    {PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_LL)},
+    {PERF_TYPE_HW_CACHE, CACHE_READ_MISS(PERF_COUNT_HW_CACHE_DTLB)},
+};
+
+int perf_counters_open(PerfCounters *pc) {
+  int available = 0;
+  for (int i = 0; i < PC_COUNT; i++) {
+    struct perf_event_attr attr;
+    memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = events[i].type;
+    attr.config = events[i].config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1; // Allowed with perf_event_paranoid <= 2
+    attr.exclude_hv = 1;
+    // More events than hardware counters get multiplexed: ask for the
+    // enabled/running times to scale the count back
+    attr.read_format =
+        PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+    pc->fd[i] = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+    if (pc->fd[i] >= 0)
+      available++;
+  }
+  return available;
+}
+
+void perf_counters_close(PerfCounters *pc) {
+  for (int i = 0; i < PC_COUNT; i++) {
+    if (pc->fd[i] >= 0)
+      close(pc->fd[i]);
+    pc->fd[i] = -1;
+  }
+}
+
+void perf_counters_start(PerfCounters *pc) {
+  for (int i = 0; i < PC_COUNT; i++)
+    if (pc->fd[i] >= 0) {
+      ioctl(pc->fd[i], PERF_EVENT_IOC_RESET, 0);
+      ioctl(pc->fd[i], PERF_EVENT_IOC_ENABLE, 0);
+    }
+}
+
+void perf_counters_stop(PerfCounters *pc, PerfSample *out) {
+  for (int i = 0; i < PC_COUNT; i++)
+    if (pc->fd[i] >= 0)
+      ioctl(pc->fd[i], PERF_EVENT_IOC_DISABLE, 0);
+
+  out->valid = 0;
+  for (int i = 0; i < PC_COUNT; i++) {
+    unsigned long long buf[3]; // value, time enabled, time running
+    out->value[i] = 0;
+    if (pc->fd[i] < 0 || read(pc->fd[i], buf, sizeof(buf)) != sizeof(buf))
+      continue;
+    if (buf[2] == 0)
+      continue; // Never scheduled on a counter
+    out->value[i] = buf[2] < buf[1]
+                        ? (long long)((double)buf[0] * buf[1] / buf[2])
+                        : (long long)buf[0];
+    out->valid |= 1u << i;
+  }
+}
+
+#else
+
+int perf_counters_open(PerfCounters *pc) {
+  for (int i = 0; i < PC_COUNT; i++)
+    pc->fd[i] = -1;
+  return 0;
+}
+
+void perf_counters_close(PerfCounters *pc) { (void)pc; }
+
+void perf_counters_start(PerfCounters *pc) { (void)pc; }
+
+void perf_counters_stop(PerfCounters *pc, PerfSample *out) {
+  (void)pc;
+  memset(out, 0, sizeof(*out));
+}
+
+#endif
@@ -0,0 +1,39 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+// Hardware counters around a code region, read through Linux perf_event_open
+// (user space only, calling thread only). Each event is opened on its own so
+// a missing one (VM, perf_event_paranoid, other OS) only drops that column.
+// No GTK dependency.
+
+typedef enum {
+  PC_CYCLES,
+  PC_INSTRUCTIONS,
+  PC_BRANCH_MISSES,
+  PC_L1D_MISSES,
+  PC_LLC_MISSES,
+  PC_DTLB_MISSES,
+  PC_COUNT
+} PerfCounterId;
+
+typedef struct {
+  int fd[PC_COUNT]; // -1 when the event could not be opened
+} PerfCounters;
+
+typedef struct {
+  unsigned int valid; // Bit i set when value[i] was read
+  long long value[PC_COUNT];
+} PerfSample;
+
+const char *perf_counter_id(PerfCounterId id);   // CSV column ("cycles", ...)
+const char *perf_counter_name(PerfCounterId id); // UI label (French)
+
+// Opens every event for the calling thread. Returns the number of events
+// available; 0 means the caller should fall back to timing only.
+int perf_counters_open(PerfCounters *pc);
+void perf_counters_close(PerfCounters *pc);
+
+void perf_counters_start(PerfCounters *pc);
+void perf_counters_stop(PerfCounters *pc, PerfSample *out);
+
+#endif
@@ -0,0 +1,91 @@
+#include "radix_sort.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define INT_DIGITS 4
+#define INT_BITS 8
+#define DBL_DIGITS 6
+#define DBL_BITS 11
+
+// Keys are unsigned and order-preserving: flipping the sign bit puts
+// negative ints first; for doubles, negatives get all bits flipped
+// (larger magnitude = smaller) and positives only the sign bit.
+// Descending order is the bitwise complement of the ascending key.
+
+// Sorts keys with a stable LSD pass per digit; tmp holds n keys.
+#define DEFINE_LSD(NAME, K, DIGITS, BITS)                                      \
+  static void NAME(K *keys, K *tmp, int n) {                                   \
+    size_t *count = calloc((size_t)DIGITS << BITS, sizeof(size_t));           \
+    const K mask = ((K)1 << BITS) - 1;                                         \
+                                                                               \
+    for (int i = 0; i < n; i++)                                                \
+      for (int d = 0; d < DIGITS; d++)                                         \
+        count[((size_t)d << BITS) + ((keys[i] >> (d * BITS)) & mask)]++;       \
+                                                                               \
+    K *src = keys, *dst = tmp;                                                 \
+    for (int d = 0; d < DIGITS; d++) {                                         \
+      size_t *c = count + ((size_t)d << BITS);                                 \
+      if (c[(src[0] >> (d * BITS)) & mask] == (size_t)n)                       \
+        continue; /* Every key has the same digit */                           \
+      size_t sum = 0;                                                          \
+      for (size_t b = 0; b <= mask; b++) {                                     \
+        size_t t = c[b];                                                       \
+        c[b] = sum;                                                            \
+        sum += t;                                                              \
+      }                                                                        \
+      for (int i = 0; i < n; i++)                                              \
+        dst[c[(src[i] >> (d * BITS)) & mask]++] = src[i];                      \
+      K *t = src;                                                              \
+      src = dst;                                                               \
+      dst = t;                                                                 \
+    }                                                                          \
+    if (src != keys)                                                           \
+      memcpy(keys, src, n * sizeof(K));                                        \
+    free(count);                                                               \
+  }
+
+DEFINE_LSD(lsd_u32, uint32_t, INT_DIGITS, INT_BITS)
+DEFINE_LSD(lsd_u64, uint64_t, DBL_DIGITS, DBL_BITS)
+
+void radix_sort_int(int *arr, int n, int descending) {
+  if (n < 2)
+    return;
+  uint32_t flip = descending ? ~0x80000000u : 0x80000000u;
+  uint32_t *keys = (uint32_t *)arr; // int/unsigned may alias: done in place
+  uint32_t *tmp = malloc(n * sizeof(uint32_t));
+
+  for (int i = 0; i < n; i++)
+    keys[i] ^= flip;
+  lsd_u32(keys, tmp, n);
+  for (int i = 0; i < n; i++)
+    keys[i] ^= flip;
+
+  free(tmp);
+}
+
+void radix_sort_double(double *arr, int n, int descending) {
+  if (n < 2)
+    return;
+  const uint64_t sign = 0x8000000000000000ull;
+  // Separate key buffer: reading doubles through a uint64_t* would break
+  // strict aliasing, memcpy does not
+  uint64_t *keys = malloc(n * sizeof(uint64_t));
+  uint64_t *tmp = malloc(n * sizeof(uint64_t));
+
+  for (int i = 0; i < n; i++) {
+    uint64_t b;
+    memcpy(&b, &arr[i], sizeof(b));
+    b = (b & sign) ? ~b : (b | sign);
+    keys[i] = descending ? ~b : b;
+  }
+  lsd_u64(keys, tmp, n);
+  for (int i = 0; i < n; i++) {
+    uint64_t b = descending ? ~keys[i] : keys[i];
+    b = (b & sign) ? (b & ~sign) : ~b;
+    memcpy(&arr[i], &b, sizeof(b));
+  }
+
+  free(keys);
+  free(tmp);
+}
@@ -0,0 +1,11 @@
+#ifndef RADIX_SORT_H
+#define RADIX_SORT_H
+
+// LSD radix sorts for the numeric types. One histogram pass counts every
+// digit, then one stable scatter per digit (skipped when all keys share it).
+// No GTK dependency.
+
+void radix_sort_int(int *arr, int n, int descending);       // 4 x 8 bits
+void radix_sort_double(double *arr, int n, int descending); // 6 x 11 bits
+
+#endif
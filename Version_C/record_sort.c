@@ -0,0 +1,188 @@
+#include "record_sort.h"
+#include "bench.h"
+#include "sort_gen.h"
+#include <stdlib.h>
+#include <string.h>
+
+static const char *layout_ids[RECORD_COUNT] = {"direct", "pointer", "index",
+                                               "keyindex"};
+
+const char *record_layout_id(int layout) { return layout_ids[layout]; }
+
+int record_layout_find(const char *id) {
+  for (int l = 0; l < RECORD_COUNT; l++)
+    if (strcmp(layout_ids[l], id) == 0)
+      return l;
+  return -1;
+}
+
+int record_size_supported(int size) {
+  return size == 8 || size == 16 || size == 64 || size == 256;
+}
+
+// --- Kernels ---
+// One instantiation per record size, so a move copies size bytes with a
+// fixed-size struct assignment
+
+typedef struct {
+  int key;
+  unsigned char payload[4];
+} Record8;
+
+typedef struct {
+  int key;
+  unsigned char payload[12];
+} Record16;
+
+typedef struct {
+  int key;
+  unsigned char payload[60];
+} Record64;
+
+typedef struct {
+  int key;
+  unsigned char payload[252];
+} Record256;
+
+typedef const void *RecordPtr; // Points at the key
+
+typedef struct {
+  int key;
+  int index;
+} KeyIndex;
+
+// Records of RECORD_INDEX: set by record_sort, one sort at a time
+static const char *index_base;
+static size_t index_size;
+
+#define KEY_GT(a, b) ((a).key > (b).key)
+#define PTR_GT(a, b) (*(const int *)(a) > *(const int *)(b))
+#define INDEX_KEY(i) (*(const int *)(index_base + (size_t)(i) * index_size))
+#define INDEX_GT(a, b) (INDEX_KEY(a) > INDEX_KEY(b))
+
+DEFINE_SORTS(rec8, Record8, KEY_GT)
+DEFINE_SORTS(rec16, Record16, KEY_GT)
+DEFINE_SORTS(rec64, Record64, KEY_GT)
+DEFINE_SORTS(rec256, Record256, KEY_GT)
+DEFINE_SORTS(rec_ptr, RecordPtr, PTR_GT)
+DEFINE_SORTS(rec_index, int, INDEX_GT)
+DEFINE_SORTS(rec_key_index, KeyIndex, KEY_GT)
+
+static void sort_direct(void *recs, int n, int size, int algo) {
+  switch (size) {
+  case 8:
+    sort_rec8(recs, n, algo);
+    break;
+  case 16:
+    sort_rec16(recs, n, algo);
+    break;
+  case 64:
+    sort_rec64(recs, n, algo);
+    break;
+  default:
+    sort_rec256(recs, n, algo);
+    break;
+  }
+}
+
+// --- Records ---
+
+static unsigned char payload_byte(int key, int j) {
+  return (unsigned char)((unsigned int)key * 31u + (unsigned int)j);
+}
+
+void *record_alloc(const int *keys, int n, int size) {
+  if (!record_size_supported(size))
+    return NULL;
+  unsigned char *recs = malloc((size_t)n * size);
+  if (!recs)
+    return NULL;
+  for (int i = 0; i < n; i++) {
+    unsigned char *r = recs + (size_t)i * size;
+    memcpy(r, &keys[i], sizeof(int));
+    for (int j = 0; j < size - (int)sizeof(int); j++)
+      r[sizeof(int) + j] = payload_byte(keys[i], j);
+  }
+  return recs;
+}
+
+int record_check(const void *recs, int n, int size) {
+  const unsigned char *r = recs;
+  int prev = 0;
+  for (int i = 0; i < n; i++, r += size) {
+    int key;
+    memcpy(&key, r, sizeof(int));
+    if (i > 0 && key < prev)
+      return 0;
+    for (int j = 0; j < size - (int)sizeof(int); j++)
+      if (r[sizeof(int) + j] != payload_byte(key, j))
+        return 0;
+    prev = key;
+  }
+  return 1;
+}
+
+// --- Sorting ---
+
+int record_sort(int layout, int algo, const void *input, void *output,
+                int n, int size, double *sort_ms, double *gather_ms) {
+  const char *in = input;
+  char *out = output;
+  double t0;
+  *gather_ms = 0;
+
+  if (layout == RECORD_DIRECT) {
+    memcpy(out, in, (size_t)n * size);
+    t0 = bench_now_ms();
+    sort_direct(out, n, size, algo);
+    *sort_ms = bench_now_ms() - t0;
+  } else if (layout == RECORD_POINTER) {
+    RecordPtr *ptrs = malloc((size_t)n * sizeof(RecordPtr));
+    if (!ptrs)
+      return -1;
+    t0 = bench_now_ms();
+    for (int i = 0; i < n; i++)
+      ptrs[i] = in + (size_t)i * size;
+    sort_rec_ptr(ptrs, n, algo);
+    *sort_ms = bench_now_ms() - t0;
+    t0 = bench_now_ms();
+    for (int i = 0; i < n; i++)
+      memcpy(out + (size_t)i * size, ptrs[i], size);
+    *gather_ms = bench_now_ms() - t0;
+    free(ptrs);
+  } else if (layout == RECORD_INDEX) {
+    int *idx = malloc((size_t)n * sizeof(int));
+    if (!idx)
+      return -1;
+    index_base = in;
+    index_size = size;
+    t0 = bench_now_ms();
+    for (int i = 0; i < n; i++)
+      idx[i] = i;
+    sort_rec_index(idx, n, algo);
+    *sort_ms = bench_now_ms() - t0;
+    t0 = bench_now_ms();
+    for (int i = 0; i < n; i++)
+      memcpy(out + (size_t)i * size, in + (size_t)idx[i] * size, size);
+    *gather_ms = bench_now_ms() - t0;
+    free(idx);
+  } else {
+    KeyIndex *pairs = malloc((size_t)n * sizeof(KeyIndex));
+    if (!pairs)
+      return -1;
+    t0 = bench_now_ms();
+    for (int i = 0; i < n; i++) {
+      memcpy(&pairs[i].key, in + (size_t)i * size, sizeof(int));
+      pairs[i].index = i;
+    }
+    sort_rec_key_index(pairs, n, algo);
+    *sort_ms = bench_now_ms() - t0;
+    t0 = bench_now_ms();
+    for (int i = 0; i < n; i++)
+      memcpy(out + (size_t)i * size, in + (size_t)pairs[i].index * size,
+             size);
+    *gather_ms = bench_now_ms() - t0;
+    free(pairs);
+  }
+  return 0;
+}
@@ -0,0 +1,39 @@
+#ifndef RECORD_SORT_H
+#define RECORD_SORT_H
+
+// Sorting records that carry a payload: an int key at offset 0 followed by
+// size - 4 bytes of data, for record sizes of 8, 16, 64 and 256 bytes. The
+// layouts compare moving the records themselves with sorting a smaller proxy
+// (pointers, indices or key-index pairs) and gathering the records in order
+// afterwards. Ascending order, comparison kernels of sort_gen.h. No GTK
+// dependency.
+
+typedef enum {
+  RECORD_DIRECT,    // Records moved in place, size bytes per move
+  RECORD_POINTER,   // Pointers sorted, every comparison loads the record key
+  RECORD_INDEX,     // int indices sorted, same loads through the index
+  RECORD_KEY_INDEX, // (key, index) pairs sorted: no record access until gather
+  RECORD_COUNT
+} RecordLayout;
+
+const char *record_layout_id(int layout); // CLI name ("direct", ...)
+int record_layout_find(const char *id);   // -1 if unknown
+
+int record_size_supported(int size);
+
+// Records of the given size with keys[i] as key; the payload bytes derive
+// from the key so record_check can tell torn records
+void *record_alloc(const int *keys, int n, int size);
+
+// Sorts the n records of input into output (n * size bytes, may not
+// overlap input) through the layout. For RECORD_DIRECT the copy into output
+// is not timed. sort_ms covers building the proxy array and sorting it,
+// gather_ms copying the records into their final place (0 for direct).
+// Returns 0, or -1 if the proxy array cannot be allocated (output untouched).
+int record_sort(int layout, int algo, const void *input, void *output,
+                int n, int size, double *sort_ms, double *gather_ms);
+
+// 1 if the records are in key order and every payload matches its key
+int record_check(const void *recs, int n, int size);
+
+#endif
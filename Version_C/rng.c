@@ -0,0 +1,142 @@
+#include "rng.h"
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stdlib.h>
+#include <time.h>
+
+#define RNG_MAX_THREADS 64
+
+static uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+static uint64_t splitmix64(uint64_t *x) {
+  uint64_t z = (*x += 0x9e3779b97f4a7c15ull);
+  z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+  z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+  return z ^ (z >> 31);
+}
+
+void rng_seed(Rng *rng, uint64_t seed) {
+  for (int i = 0; i < 4; i++)
+    rng->s[i] = splitmix64(&seed); // Never all zero
+}
+
+uint64_t rng_next(Rng *rng) {
+  uint64_t *s = rng->s;
+  uint64_t result = rotl(s[1] * 5, 7) * 9;
+  uint64_t t = s[1] << 17;
+  s[2] ^= s[0];
+  s[3] ^= s[1];
+  s[1] ^= s[2];
+  s[0] ^= s[3];
+  s[2] ^= t;
+  s[3] = rotl(s[3], 45);
+  return result;
+}
+
+void rng_jump(Rng *rng) {
+  static const uint64_t jump[4] = {
+      0x180ec6d33cfd0abaull, 0xd5a61266f0c9392cull, 0xa9582618e03fc9aaull,
+      0x39abdc4529b1661cull};
+  uint64_t s[4] = {0, 0, 0, 0};
+  for (int i = 0; i < 4; i++)
+    for (int b = 0; b < 64; b++) {
+      if (jump[i] & (1ull << b))
+        for (int k = 0; k < 4; k++)
+          s[k] ^= rng->s[k];
+      rng_next(rng);
+    }
+  for (int k = 0; k < 4; k++)
+    rng->s[k] = s[k];
+}
+
+void rng_stream(Rng *rng, uint64_t seed, int stream) {
+  rng_seed(rng, seed);
+  for (int i = 0; i < stream; i++)
+    rng_jump(rng);
+}
+
+// Lemire's multiply-shift: the high half of a 32x32 product, redrawn in the
+// rare low-half cases that would bias it
+uint32_t rng_below(Rng *rng, uint32_t bound) {
+  uint64_t m = (rng_next(rng) >> 32) * bound;
+  uint32_t low = (uint32_t)m;
+  if (low < bound) {
+    uint32_t threshold = -bound % bound;
+    while (low < threshold) {
+      m = (rng_next(rng) >> 32) * bound;
+      low = (uint32_t)m;
+    }
+  }
+  return (uint32_t)(m >> 32);
+}
+
+double rng_double(Rng *rng) { return (rng_next(rng) >> 11) * 0x1.0p-53; }
+
+unsigned int rng_fresh_seed(void) {
+  static atomic_uint counter;
+  struct timespec ts;
+  clock_gettime(CLOCK_REALTIME, &ts);
+  uint64_t x = (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec +
+               ((uint64_t)atomic_fetch_add(&counter, 1) << 32);
+  return (unsigned int)splitmix64(&x);
+}
+
+unsigned int rng_seed_or_fresh(unsigned int seed) {
+  return seed ? seed : rng_fresh_seed();
+}
+
+// --- Parallel Fill ---
+
+typedef struct {
+  int *arr;
+  int n;
+  const Rng *streams; // One per chunk
+  int chunks;
+  atomic_int next; // Next chunk to fill
+  RngFillFunc fill;
+  void *ctx;
+} FillJob;
+
+static void *fill_worker(void *data) {
+  FillJob *job = data;
+  int c;
+  while ((c = atomic_fetch_add(&job->next, 1)) < job->chunks) {
+    Rng rng = job->streams[c];
+    int start = c * RNG_CHUNK;
+    int count = job->n - start < RNG_CHUNK ? job->n - start : RNG_CHUNK;
+    job->fill(job->arr + start, count, &rng, job->ctx);
+  }
+  return NULL;
+}
+
+int rng_fill_streams(int n) { return (n + RNG_CHUNK - 1) / RNG_CHUNK; }
+
+void rng_fill_parallel(int *arr, int n, uint64_t seed, int threads,
+                       RngFillFunc fill, void *ctx) {
+  int chunks = rng_fill_streams(n);
+  if (chunks == 0)
+    return;
+  Rng *streams = malloc(chunks * sizeof(Rng));
+  rng_seed(&streams[0], seed);
+  for (int c = 1; c < chunks; c++) {
+    streams[c] = streams[c - 1];
+    rng_jump(&streams[c]);
+  }
+
+  FillJob job = {arr, n, streams, chunks, 0, fill, ctx};
+  if (threads > chunks)
+    threads = chunks;
+  if (threads > RNG_MAX_THREADS)
+    threads = RNG_MAX_THREADS;
+  // Chunks go to whichever worker asks next, so the caller alone still fills
+  // everything if no thread can be started
+  pthread_t tids[RNG_MAX_THREADS];
+  int started[RNG_MAX_THREADS] = {0};
+  for (int t = 1; t < threads; t++)
+    started[t] = pthread_create(&tids[t], NULL, fill_worker, &job) == 0;
+  fill_worker(&job); // The caller is the first worker
+  for (int t = 1; t < threads; t++)
+    if (started[t])
+      pthread_join(tids[t], NULL);
+  free(streams);
+}
@@ -0,0 +1,45 @@
+#ifndef RNG_H
+#define RNG_H
+
+// Seeded pseudo-random generator shared by every data generator:
+// xoshiro256** (Blackman & Vigna), state expanded from a 64-bit seed by
+// splitmix64. rng_jump advances a state by 2^128 draws, so one seed splits
+// into non-overlapping streams that threads can draw from independently.
+// Not thread safe per Rng: one state per thread. No GTK dependency.
+
+#include <stdint.h>
+
+typedef struct {
+  uint64_t s[4];
+} Rng;
+
+void rng_seed(Rng *rng, uint64_t seed);
+void rng_jump(Rng *rng);
+// State of rng_seed(seed) after `stream` jumps
+void rng_stream(Rng *rng, uint64_t seed, int stream);
+
+uint64_t rng_next(Rng *rng);
+uint32_t rng_below(Rng *rng, uint32_t bound); // Uniform in [0, bound)
+double rng_double(Rng *rng);                  // Uniform in [0, 1)
+
+// A new seed for each generated dataset (clock and a counter), for callers
+// that do not take one from the user. Thread safe.
+unsigned int rng_fresh_seed(void);
+// seed itself, or a fresh one when 0 (the "0 = nouvelle" seed inputs)
+unsigned int rng_seed_or_fresh(unsigned int seed);
+
+// Parallel fill: arr is cut into chunks of RNG_CHUNK elements and chunk k
+// is filled by fill(chunk, count, rng, ctx) with rng at rng_stream(seed, k).
+// The result depends on the seed only, not on the thread count.
+#define RNG_CHUNK 65536
+
+typedef void (*RngFillFunc)(int *chunk, int count, Rng *rng, void *ctx);
+
+void rng_fill_parallel(int *arr, int n, uint64_t seed, int threads,
+                       RngFillFunc fill, void *ctx);
+
+// Number of streams rng_fill_parallel uses for n elements; streams from this
+// one on are free for the caller
+int rng_fill_streams(int n);
+
+#endif
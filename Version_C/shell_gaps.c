@@ -0,0 +1,79 @@
+#include "shell_gaps.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *gap_ids[GAPS_COUNT] = {"shell", "ciura", "tokuda",
+                                          "sedgewick", "pratt"};
+static const char *gap_names[GAPS_COUNT] = {
+    "Shell (n/2, n/4...)", "Ciura", "Tokuda", "Sedgewick", "Pratt (2^p 3^q)"};
+
+static int gap_seq = SHELL_GAPS_DEFAULT;
+
+const char *shell_gaps_id(int seq) { return gap_ids[seq]; }
+
+const char *shell_gaps_name(int seq) { return gap_names[seq]; }
+
+int shell_gaps_find(const char *id) {
+  for (int s = 0; s < GAPS_COUNT; s++)
+    if (strcmp(gap_ids[s], id) == 0)
+      return s;
+  return -1;
+}
+
+void shell_set_gaps(int seq) {
+  if (seq >= 0 && seq < GAPS_COUNT)
+    gap_seq = seq;
+}
+
+int shell_get_gaps(void) { return gap_seq; }
+
+static int cmp_int_desc(const void *a, const void *b) {
+  int x = *(const int *)a, y = *(const int *)b;
+  return (x < y) - (x > y);
+}
+
+// Increasing gaps below n, from 1: the other sequences are generated upwards
+static int ascending_gaps(int seq, int n, int *gaps) {
+  static const int ciura[] = {1, 4, 10, 23, 57, 132, 301, 701};
+  int count = 0;
+  switch (seq) {
+  case GAPS_CIURA:
+    for (int i = 0; i < 8 && ciura[i] < n; i++)
+      gaps[count++] = ciura[i];
+    // Past the measured prefix: the usual x2.25 extension
+    for (double h = 701 * 2.25; count >= 8 && h < n; h *= 2.25)
+      gaps[count++] = (int)h;
+    break;
+  case GAPS_TOKUDA:
+    for (double h = 1; ceil(h) < n; h = 2.25 * h + 1)
+      gaps[count++] = (int)ceil(h);
+    break;
+  case GAPS_SEDGEWICK:
+    gaps[count++] = 1;
+    for (long long p4 = 4, p2 = 1; p4 + 3 * p2 + 1 < n; p4 *= 4, p2 *= 2)
+      gaps[count++] = (int)(p4 + 3 * p2 + 1);
+    break;
+  case GAPS_PRATT:
+    for (long long p3 = 1; p3 < n; p3 *= 3)
+      for (long long g = p3; g < n && count < SHELL_MAX_GAPS; g *= 2)
+        gaps[count++] = (int)g;
+    break;
+  }
+  return count;
+}
+
+int shell_gaps(int seq, int n, int *gaps) {
+  if (n < 2)
+    return 0;
+  int count = 0;
+  if (seq == GAPS_SHELL) {
+    for (int gap = n / 2; gap > 0; gap /= 2)
+      gaps[count++] = gap;
+    return count;
+  }
+
+  count = ascending_gaps(seq, n, gaps);
+  qsort(gaps, count, sizeof(int), cmp_int_desc); // Pratt comes unordered
+  return count;
+}
@@ -0,0 +1,31 @@
+#ifndef SHELL_GAPS_H
+#define SHELL_GAPS_H
+
+// Gap sequences for Shell sort. Every Shell sort (sort_gen.h, shell_bench,
+// the void** reference) takes its gaps from shell_gaps() with the sequence of
+// shell_set_gaps(), so one setting switches them all. No GTK dependency.
+
+typedef enum {
+  GAPS_SHELL,     // n/2, n/4, ..., 1 (Shell 1959): O(n^2) worst case
+  GAPS_CIURA,     // 1, 4, 10, 23, 57, 132, 301, 701, then x2.25 (Ciura 2001)
+  GAPS_TOKUDA,    // ceil(h), h = 2.25 h + 1: 1, 4, 9, 20, 46... (Tokuda 1992)
+  GAPS_SEDGEWICK, // 1, then 4^k + 3 * 2^(k-1) + 1: 8, 23, 77... (1986)
+  GAPS_PRATT,     // Every 2^p 3^q: O(n log^2 n), many passes (Pratt 1971)
+  GAPS_COUNT
+} ShellGaps;
+
+#define SHELL_MAX_GAPS 512 // Pratt's sequence below INT_MAX has ~340 gaps
+#define SHELL_GAPS_DEFAULT GAPS_CIURA
+
+const char *shell_gaps_id(int seq);   // CLI name ("ciura", ...)
+const char *shell_gaps_name(int seq); // UI label
+int shell_gaps_find(const char *id);  // -1 if unknown
+
+// Writes the gaps of seq below n into gaps (SHELL_MAX_GAPS entries), largest
+// first and ending with 1. Returns the count, 0 when n < 2.
+int shell_gaps(int seq, int n, int *gaps);
+
+void shell_set_gaps(int seq); // Sequence used by every Shell sort
+int shell_get_gaps(void);
+
+#endif
@@ -0,0 +1,209 @@
+#include "simd_sort.h"
+#include "sort_gen.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define GT(a, b) ((a) > (b))
+DEFINE_INTROSORT(scalar, int, GT)
+
+static void reverse_int(int *arr, int n) {
+  for (int i = 0, j = n - 1; i < j; i++, j--) {
+    int t = arr[i];
+    arr[i] = arr[j];
+    arr[j] = t;
+  }
+}
+
+#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__)
+#include <immintrin.h>
+
+#define AVX2 __attribute__((target("avx2")))
+
+// --- In-register primitives ---
+
+// Compare-exchange of two registers: lane-wise min to a, max to b
+#define CMPX(a, b)                                                             \
+  do {                                                                         \
+    __m256i t_ = _mm256_min_epi32(a, b);                                       \
+    b = _mm256_max_epi32(a, b);                                                \
+    a = t_;                                                                    \
+  } while (0)
+
+static AVX2 inline __m256i reverse8(__m256i v) {
+  return _mm256_permutevar8x32_epi32(v, _mm256_setr_epi32(7, 6, 5, 4, 3, 2,
+                                                          1, 0));
+}
+
+// Sorts a bitonic sequence of 8 ints held in one register
+static AVX2 inline __m256i bitonic_clean8(__m256i v) {
+  __m256i p = _mm256_permute2x128_si256(v, v, 0x01); // Distance 4
+  v = _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), 0xF0);
+  p = _mm256_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)); // Distance 2
+  v = _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), 0xCC);
+  p = _mm256_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)); // Distance 1
+  v = _mm256_blend_epi32(_mm256_min_epi32(v, p), _mm256_max_epi32(v, p), 0xAA);
+  return v;
+}
+
+// a and b sorted: afterwards a holds the 8 smallest, b the 8 largest, sorted
+static AVX2 inline void bitonic_merge16(__m256i *a, __m256i *b) {
+  __m256i r = reverse8(*b);
+  __m256i lo = _mm256_min_epi32(*a, r);
+  __m256i hi = _mm256_max_epi32(*a, r);
+  *a = bitonic_clean8(lo);
+  *b = bitonic_clean8(hi);
+}
+
+static AVX2 void transpose8(__m256i r[8]) {
+  __m256i t0 = _mm256_unpacklo_epi32(r[0], r[1]);
+  __m256i t1 = _mm256_unpackhi_epi32(r[0], r[1]);
+  __m256i t2 = _mm256_unpacklo_epi32(r[2], r[3]);
+  __m256i t3 = _mm256_unpackhi_epi32(r[2], r[3]);
+  __m256i t4 = _mm256_unpacklo_epi32(r[4], r[5]);
+  __m256i t5 = _mm256_unpackhi_epi32(r[4], r[5]);
+  __m256i t6 = _mm256_unpacklo_epi32(r[6], r[7]);
+  __m256i t7 = _mm256_unpackhi_epi32(r[6], r[7]);
+  __m256i u0 = _mm256_unpacklo_epi64(t0, t2);
+  __m256i u1 = _mm256_unpackhi_epi64(t0, t2);
+  __m256i u2 = _mm256_unpacklo_epi64(t1, t3);
+  __m256i u3 = _mm256_unpackhi_epi64(t1, t3);
+  __m256i u4 = _mm256_unpacklo_epi64(t4, t6);
+  __m256i u5 = _mm256_unpackhi_epi64(t4, t6);
+  __m256i u6 = _mm256_unpacklo_epi64(t5, t7);
+  __m256i u7 = _mm256_unpackhi_epi64(t5, t7);
+  r[0] = _mm256_permute2x128_si256(u0, u4, 0x20);
+  r[1] = _mm256_permute2x128_si256(u1, u5, 0x20);
+  r[2] = _mm256_permute2x128_si256(u2, u6, 0x20);
+  r[3] = _mm256_permute2x128_si256(u3, u7, 0x20);
+  r[4] = _mm256_permute2x128_si256(u0, u4, 0x31);
+  r[5] = _mm256_permute2x128_si256(u1, u5, 0x31);
+  r[6] = _mm256_permute2x128_si256(u2, u6, 0x31);
+  r[7] = _mm256_permute2x128_si256(u3, u7, 0x31);
+}
+
+// Sorts 64 ints into 8 consecutive sorted runs of 8: Batcher's 19
+// comparator network sorts the columns, the transpose turns them into rows.
+static AVX2 void sort_block64(int *p) {
+  __m256i r[8];
+  for (int i = 0; i < 8; i++)
+    r[i] = _mm256_loadu_si256((const __m256i *)(p + 8 * i));
+
+  // Layer 1
+  CMPX(r[0], r[1]);
+  CMPX(r[2], r[3]);
+  CMPX(r[4], r[5]);
+  CMPX(r[6], r[7]);
+  // Layer 2
+  CMPX(r[0], r[2]);
+  CMPX(r[1], r[3]);
+  CMPX(r[4], r[6]);
+  CMPX(r[5], r[7]);
+  // Layer 3
+  CMPX(r[1], r[2]);
+  CMPX(r[5], r[6]);
+  // Layer 4
+  CMPX(r[0], r[4]);
+  CMPX(r[1], r[5]);
+  CMPX(r[2], r[6]);
+  CMPX(r[3], r[7]);
+  // Layer 5
+  CMPX(r[2], r[4]);
+  CMPX(r[3], r[5]);
+  // Layer 6
+  CMPX(r[1], r[2]);
+  CMPX(r[3], r[4]);
+  CMPX(r[5], r[6]);
+
+  transpose8(r);
+  for (int i = 0; i < 8; i++)
+    _mm256_storeu_si256((__m256i *)(p + 8 * i), r[i]);
+}
+
+// Merges sorted a[0..la) and b[0..lb) (multiples of 8) into out, 8 at a
+// time: the upper half of each bitonic merge waits for the next chunk,
+// taken from whichever input has the smaller head.
+static AVX2 void merge_runs(const int *a, int la, const int *b, int lb,
+                            int *out) {
+  if (la == 0 || lb == 0) {
+    memcpy(out, la ? a : b, (size_t)(la + lb) * sizeof(int));
+    return;
+  }
+  const int *ea = a + la, *eb = b + lb;
+  __m256i lo = _mm256_loadu_si256((const __m256i *)a);
+  __m256i hi = _mm256_loadu_si256((const __m256i *)b);
+  a += 8;
+  b += 8;
+  for (;;) {
+    bitonic_merge16(&lo, &hi);
+    _mm256_storeu_si256((__m256i *)out, lo);
+    out += 8;
+    const int **src;
+    if (a == ea && b == eb)
+      break;
+    if (a == ea)
+      src = &b;
+    else if (b == eb)
+      src = &a;
+    else
+      src = (*a <= *b) ? &a : &b;
+    lo = _mm256_loadu_si256((const __m256i *)*src);
+    *src += 8;
+  }
+  _mm256_storeu_si256((__m256i *)out, hi);
+}
+
+// n is a multiple of 64; buf has room for n ints
+static AVX2 void simd_sort_padded(int *arr, int *buf, int n) {
+  for (int i = 0; i < n; i += 64)
+    sort_block64(arr + i);
+
+  int *src = arr, *dst = buf;
+  for (int width = 8; width < n; width *= 2) {
+    for (int lo = 0; lo < n; lo += 2 * width) {
+      int mid = lo + width < n ? lo + width : n;
+      int hi = lo + 2 * width < n ? lo + 2 * width : n;
+      merge_runs(src + lo, mid - lo, src + mid, hi - mid, dst + lo);
+    }
+    int *t = src;
+    src = dst;
+    dst = t;
+  }
+  if (src != arr)
+    memcpy(arr, src, (size_t)n * sizeof(int));
+}
+
+int simd_sort_available(void) {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2") != 0;
+}
+
+void simd_sort_int(int *arr, int n, int descending) {
+  if (n < 64 || !simd_sort_available()) {
+    introsort_scalar(arr, n);
+  } else {
+    // Pad to a multiple of 64 with INT_MAX, which sorts to the end
+    int padded = (n + 63) & ~63;
+    int *work = malloc((size_t)padded * 2 * sizeof(int));
+    memcpy(work, arr, (size_t)n * sizeof(int));
+    for (int i = n; i < padded; i++)
+      work[i] = INT_MAX;
+    simd_sort_padded(work, work + padded, padded);
+    memcpy(arr, work, (size_t)n * sizeof(int));
+    free(work);
+  }
+  if (descending)
+    reverse_int(arr, n);
+}
+
+#else
+
+int simd_sort_available(void) { return 0; }
+
+void simd_sort_int(int *arr, int n, int descending) {
+  introsort_scalar(arr, n);
+  if (descending)
+    reverse_int(arr, n);
+}
+
+#endif
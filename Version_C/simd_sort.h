@@ -0,0 +1,12 @@
+#ifndef SIMD_SORT_H
+#define SIMD_SORT_H
+
+// Vectorised sort for 32-bit ints: AVX2 sorting network on 8x8 blocks, then
+// bitonic in-register merging of the sorted runs. The CPU is checked at run
+// time; without AVX2 (or on non-x86 builds) the scalar introsort is used.
+// No GTK dependency.
+
+int simd_sort_available(void); // 1 when the AVX2 path is used
+void simd_sort_int(int *arr, int n, int descending);
+
+#endif
@@ -0,0 +1,111 @@
+#include "sort.h"
+#include "block_sort.h"
+#include "parallel_sort.h"
+#include "radix_sort.h"
+#include "shell_gaps.h"
+#include "simd_sort.h"
+#include "sort_gen.h"
+#include <string.h>
+
+// --- Benchmark Algos (Int Only for Graph speed) ---
+static void swap_int(int *a, int *b) {
+  int t = *a;
+  *a = *b;
+  *b = t;
+}
+
+void bubble_bench(int *arr, int n) {
+  for (int k = 0; k < n - 1; k++)
+    for (int l = 0; l < n - k - 1; l++)
+      if (arr[l] > arr[l + 1])
+        swap_int(&arr[l], &arr[l + 1]);
+}
+void insertion_bench(int *arr, int n) {
+  for (int k = 1; k < n; k++) {
+    int key = arr[k];
+    int l = k - 1;
+    while (l >= 0 && arr[l] > key) {
+      arr[l + 1] = arr[l];
+      l--;
+    }
+    arr[l + 1] = key;
+  }
+}
+void shell_bench(int *arr, int n) {
+  int gaps[SHELL_MAX_GAPS];
+  int count = shell_gaps(shell_get_gaps(), n, gaps);
+  for (int g = 0; g < count; g++) {
+    int gap = gaps[g];
+    for (int k = gap; k < n; k++) {
+      int temp = arr[k];
+      int l;
+      for (l = k; l >= gap && arr[l - gap] > temp; l -= gap)
+        arr[l] = arr[l - gap];
+      arr[l] = temp;
+    }
+  }
+}
+static int partition(int *arr, int l, int h) {
+  int p = arr[h];
+  int i = (l - 1);
+  for (int j = l; j <= h - 1; j++) {
+    if (arr[j] < p) {
+      i++;
+      swap_int(&arr[i], &arr[j]);
+    }
+  }
+  swap_int(&arr[i + 1], &arr[h]);
+  return (i + 1);
+}
+void quick_bench(int *arr, int l, int h) {
+  if (l < h) {
+    int pi = partition(arr, l, h);
+    quick_bench(arr, l, pi - 1);
+    quick_bench(arr, pi + 1, h);
+  }
+}
+static void quick_bench_n(int *arr, int n) { quick_bench(arr, 0, n - 1); }
+
+#define GT(a, b) ((a) > (b))
+DEFINE_INTROSORT(bench, int, GT)
+DEFINE_TIMSORT(bench, int, GT)
+
+void intro_bench(int *arr, int n) { introsort_bench(arr, n); }
+void radix_bench(int *arr, int n) { radix_sort_int(arr, n, 0); }
+void parallel_bench(int *arr, int n) { parallel_sort_int(arr, n, 0, 0); }
+void simd_bench(int *arr, int n) { simd_sort_int(arr, n, 0); }
+void tim_bench(int *arr, int n) { timsort_bench(arr, n); }
+void block_bench(int *arr, int n) { block_sort_int(arr, n, 0); }
+
+// --- Kernel Table ---
+const SortKernel sort_kernels[] = {
+    {"Bulle", "bubble", bubble_bench},
+    {"Insertion", "insertion", insertion_bench},
+    {"Shell", "shell", shell_bench},
+    {"Rapide", "quick", quick_bench_n},
+    {"Introsort", "intro", intro_bench},
+    {"Radix LSD", "radix", radix_bench},
+    {"Parallele", "parallel", parallel_bench},
+    {"SIMD (AVX2)", "simd", simd_bench},
+    {"TimSort", "tim", tim_bench},
+    {"Quick bloc (sans branche)", "block", block_bench},
+};
+const int sort_kernel_count = sizeof(sort_kernels) / sizeof(sort_kernels[0]);
+
+int sort_kernel_find(const char *id) {
+  for (int a = 0; a < sort_kernel_count; a++)
+    if (strcmp(sort_kernels[a].id, id) == 0)
+      return a;
+  return -1;
+}
+
+int sort_is_comparison(int algo) {
+  return (algo >= ALGO_BUBBLE && algo <= ALGO_INTRO) || algo == ALGO_TIM;
+}
+
+int is_sorted_int(const int *arr, int n) {
+  for (int k = 1; k < n; k++)
+    if (arr[k - 1] > arr[k])
+      return 0;
+  return 1;
+}
@@ -0,0 +1,54 @@
+#ifndef SORT_H
+#define SORT_H
+
+// Integer sorting kernels used by the "Comparer" graph and by the headless
+// benchmark (bench/sort_bench.c). This header must not depend on GTK.
+
+typedef void (*SortFunc)(int *arr, int n);
+
+typedef struct {
+  const char *name;  // Label shown in the graph legend
+  const char *id;    // Short identifier used on the command line / exports
+  SortFunc run;
+} SortKernel;
+
+// Index of each algorithm in sort_kernels, the "Algorithme" combo and the
+// typed/boxed dispatchers
+typedef enum {
+  ALGO_BUBBLE,
+  ALGO_INSERTION,
+  ALGO_SHELL,
+  ALGO_QUICK,
+  ALGO_INTRO,
+  ALGO_RADIX,
+  ALGO_PARALLEL,
+  ALGO_SIMD,
+  ALGO_TIM,
+  ALGO_BLOCK,
+} SortAlgo;
+
+// Kernels in the same order as the "Comparer" curves
+#define SORT_KERNEL_MAX 16 // Capacity for per-algorithm arrays in the UI
+extern const SortKernel sort_kernels[];
+extern const int sort_kernel_count;
+
+int sort_kernel_find(const char *id); // Index in sort_kernels, -1 if unknown
+
+void bubble_bench(int *arr, int n);
+void insertion_bench(int *arr, int n);
+void shell_bench(int *arr, int n);
+void quick_bench(int *arr, int l, int h);
+void intro_bench(int *arr, int n);
+void radix_bench(int *arr, int n);
+void parallel_bench(int *arr, int n); // Uses parallel_get_threads()
+void simd_bench(int *arr, int n);
+void tim_bench(int *arr, int n);
+void block_bench(int *arr, int n); // Branchless block partitioning
+
+// Sequential comparison sorts: the ones with boxed (void**) and
+// operation-counting versions
+int sort_is_comparison(int algo);
+
+int is_sorted_int(const int *arr, int n);
+
+#endif
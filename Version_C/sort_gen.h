@@ -0,0 +1,693 @@
+#ifndef SORT_GEN_H
+#define SORT_GEN_H
+
+#include "shell_gaps.h"
+#include "sort.h"
+#include "typed_sort.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Macro templates for the sort kernels. Each DEFINE_* expands to static
+// functions for element type T. OUT_OF_ORDER(a, b) is true when a must be
+// placed after b, so the direction is baked into the kernel and the
+// comparison is inlined. No GTK dependency.
+//
+// SORT_OP_SWAP() and SORT_OP_MOVE() mark every element exchange and every
+// single-element write, SORT_OP_MOVES(k) a block copy of k elements. They
+// expand to nothing unless defined before this header is included, so only
+// op_count.c pays for counting.
+
+#ifndef SORT_OP_SWAP
+#define SORT_OP_SWAP() ((void)0)
+#endif
+#ifndef SORT_OP_MOVE
+#define SORT_OP_MOVE() ((void)0)
+#endif
+#ifndef SORT_OP_MOVES
+#define SORT_OP_MOVES(k) ((void)(k))
+#endif
+
+#define DEFINE_BUBBLE(SUFFIX, T, OUT_OF_ORDER)                                 \
+  static void bubble_##SUFFIX(T *arr, int n) {                                 \
+    for (int i = 0; i < n - 1; i++)                                            \
+      for (int j = 0; j < n - i - 1; j++)                                      \
+        if (OUT_OF_ORDER(arr[j], arr[j + 1])) {                                \
+          T t = arr[j];                                                        \
+          arr[j] = arr[j + 1];                                                 \
+          arr[j + 1] = t;                                                      \
+          SORT_OP_SWAP();                                                      \
+        }                                                                      \
+  }
+
+#define DEFINE_INSERTION(SUFFIX, T, OUT_OF_ORDER)                              \
+  static void insertion_##SUFFIX(T *arr, int n) {                              \
+    for (int i = 1; i < n; i++) {                                              \
+      T key = arr[i];                                                          \
+      int j = i - 1;                                                           \
+      while (j >= 0 && OUT_OF_ORDER(arr[j], key)) {                            \
+        arr[j + 1] = arr[j];                                                   \
+        SORT_OP_MOVE();                                                        \
+        j--;                                                                   \
+      }                                                                        \
+      arr[j + 1] = key;                                                        \
+      SORT_OP_MOVE();                                                          \
+    }                                                                          \
+  }
+
+#define DEFINE_SHELL(SUFFIX, T, OUT_OF_ORDER)                                  \
+  /* One gapped insertion sort per gap, gaps from shell_gaps.h */              \
+  static void shell_##SUFFIX(T *arr, int n) {                                  \
+    int gaps[SHELL_MAX_GAPS];                                                  \
+    int count = shell_gaps(shell_get_gaps(), n, gaps);                         \
+    for (int g = 0; g < count; g++) {                                          \
+      int gap = gaps[g];                                                       \
+      for (int i = gap; i < n; i++) {                                          \
+        T temp = arr[i];                                                       \
+        int j;                                                                 \
+        for (j = i; j >= gap && OUT_OF_ORDER(arr[j - gap], temp); j -= gap) {  \
+          arr[j] = arr[j - gap];                                               \
+          SORT_OP_MOVE();                                                      \
+        }                                                                      \
+        arr[j] = temp;                                                         \
+        SORT_OP_MOVE();                                                        \
+      }                                                                        \
+    }                                                                          \
+  }
+
+#define DEFINE_QUICK(SUFFIX, T, OUT_OF_ORDER)                                  \
+  static void quick_##SUFFIX(T *arr, int low, int high) {                      \
+    if (low >= high)                                                           \
+      return;                                                                  \
+    T pivot = arr[high];                                                       \
+    int i = low - 1;                                                           \
+    for (int j = low; j < high; j++) {                                         \
+      if (OUT_OF_ORDER(pivot, arr[j])) {                                       \
+        i++;                                                                   \
+        T t = arr[i];                                                          \
+        arr[i] = arr[j];                                                       \
+        arr[j] = t;                                                            \
+        SORT_OP_SWAP();                                                        \
+      }                                                                        \
+    }                                                                          \
+    T t = arr[i + 1];                                                          \
+    arr[i + 1] = arr[high];                                                    \
+    arr[high] = t;                                                             \
+    SORT_OP_SWAP();                                                            \
+    quick_##SUFFIX(arr, low, i);                                               \
+    quick_##SUFFIX(arr, i + 2, high);                                          \
+  }
+
+// Introsort: ninther (median-of-three for small ranges) pivot, three-way
+// partition so duplicates are not recursed into, insertion sort below
+// INTRO_CUTOFF and heapsort once the depth budget (2*log2 n) is spent.
+// Recurses on the smaller side only, so the stack stays O(log n).
+#define INTRO_CUTOFF 16
+#define INTRO_NINTHER_MIN 128
+
+#define DEFINE_INTROSORT(SUFFIX, T, OUT_OF_ORDER)                              \
+  static void sift_down_##SUFFIX(T *arr, int root, int n) {                    \
+    for (;;) {                                                                 \
+      int child = 2 * root + 1;                                                \
+      if (child >= n)                                                          \
+        return;                                                                \
+      if (child + 1 < n && OUT_OF_ORDER(arr[child + 1], arr[child]))           \
+        child++;                                                               \
+      if (!OUT_OF_ORDER(arr[child], arr[root]))                                \
+        return;                                                                \
+      T t = arr[root];                                                         \
+      arr[root] = arr[child];                                                  \
+      arr[child] = t;                                                          \
+      SORT_OP_SWAP();                                                          \
+      root = child;                                                            \
+    }                                                                          \
+  }                                                                            \
+  static void heap_sort_##SUFFIX(T *arr, int n) {                              \
+    for (int i = n / 2 - 1; i >= 0; i--)                                       \
+      sift_down_##SUFFIX(arr, i, n);                                           \
+    for (int end = n - 1; end > 0; end--) {                                    \
+      T t = arr[0];                                                            \
+      arr[0] = arr[end];                                                       \
+      arr[end] = t;                                                            \
+      SORT_OP_SWAP();                                                          \
+      sift_down_##SUFFIX(arr, 0, end);                                         \
+    }                                                                          \
+  }                                                                            \
+  static void intro_insertion_##SUFFIX(T *arr, int n) {                        \
+    for (int i = 1; i < n; i++) {                                              \
+      T key = arr[i];                                                          \
+      int j = i - 1;                                                           \
+      while (j >= 0 && OUT_OF_ORDER(arr[j], key)) {                            \
+        arr[j + 1] = arr[j];                                                   \
+        SORT_OP_MOVE();                                                        \
+        j--;                                                                   \
+      }                                                                        \
+      arr[j + 1] = key;                                                        \
+      SORT_OP_MOVE();                                                          \
+    }                                                                          \
+  }                                                                            \
+  static int median3_##SUFFIX(T *arr, int a, int b, int c) {                   \
+    if (OUT_OF_ORDER(arr[a], arr[b])) {                                        \
+      int t = a;                                                               \
+      a = b;                                                                   \
+      b = t;                                                                   \
+    }                                                                          \
+    if (OUT_OF_ORDER(arr[b], arr[c]))                                          \
+      return OUT_OF_ORDER(arr[a], arr[c]) ? a : c;                             \
+    return b;                                                                  \
+  }                                                                            \
+  /* Ninther/median-of-three pivot, then [lo,lt) < pivot, [lt,gt] == pivot, */ \
+  /* (gt,hi) > pivot */                                                        \
+  static void partition3_##SUFFIX(T *arr, int lo, int hi, int *lt_out,         \
+                                  int *gt_out) {                               \
+    int n = hi - lo, mid = lo + n / 2, m;                                      \
+    if (n >= INTRO_NINTHER_MIN) {                                              \
+      int s = n / 8;                                                           \
+      m = median3_##SUFFIX(                                                    \
+          arr, median3_##SUFFIX(arr, lo, lo + s, lo + 2 * s),                  \
+          median3_##SUFFIX(arr, mid - s, mid, mid + s),                        \
+          median3_##SUFFIX(arr, hi - 1 - 2 * s, hi - 1 - s, hi - 1));          \
+    } else {                                                                   \
+      m = median3_##SUFFIX(arr, lo, mid, hi - 1);                              \
+    }                                                                          \
+    T pivot = arr[m];                                                          \
+    int lt = lo, i = lo, gt = hi - 1;                                          \
+    while (i <= gt) {                                                          \
+      if (OUT_OF_ORDER(pivot, arr[i])) {                                       \
+        T t = arr[lt];                                                         \
+        arr[lt++] = arr[i];                                                    \
+        arr[i++] = t;                                                          \
+        SORT_OP_SWAP();                                                        \
+      } else if (OUT_OF_ORDER(arr[i], pivot)) {                                \
+        T t = arr[gt];                                                         \
+        arr[gt--] = arr[i];                                                    \
+        arr[i] = t;                                                            \
+        SORT_OP_SWAP();                                                        \
+      } else {                                                                 \
+        i++;                                                                   \
+      }                                                                        \
+    }                                                                          \
+    *lt_out = lt;                                                              \
+    *gt_out = gt;                                                              \
+  }                                                                            \
+  static void intro_loop_##SUFFIX(T *arr, int lo, int hi, int depth) {         \
+    while (hi - lo > INTRO_CUTOFF) {                                           \
+      if (depth-- == 0) {                                                      \
+        heap_sort_##SUFFIX(arr + lo, hi - lo);                                 \
+        return;                                                                \
+      }                                                                        \
+      int lt, gt;                                                              \
+      partition3_##SUFFIX(arr, lo, hi, &lt, &gt);                              \
+      if (lt - lo < hi - gt - 1) {                                             \
+        intro_loop_##SUFFIX(arr, lo, lt, depth);                               \
+        lo = gt + 1;                                                           \
+      } else {                                                                 \
+        intro_loop_##SUFFIX(arr, gt + 1, hi, depth);                           \
+        hi = lt;                                                               \
+      }                                                                        \
+    }                                                                          \
+    intro_insertion_##SUFFIX(arr + lo, hi - lo);                               \
+  }                                                                            \
+  static void introsort_##SUFFIX(T *arr, int n) {                              \
+    int depth = 0;                                                             \
+    for (int k = n; k > 1; k >>= 1)                                            \
+      depth += 2;                                                              \
+    intro_loop_##SUFFIX(arr, 0, n, depth);                                     \
+  }
+
+// Selection on top of the Introsort helpers (expand DEFINE_INTROSORT or
+// DEFINE_SORTS with the same SUFFIX first): the k first elements of the
+// sort order without sorting everything.
+#define DEFINE_SELECT(SUFFIX, T, OUT_OF_ORDER)                                 \
+  /* Introselect: quickselect on partition3 until position k falls in the      \
+     pivot block, heap sort of what is left once the depth budget is           \
+     spent. arr[k] ends in place, with no larger element before it and no      \
+     smaller one after */                                                      \
+  static void nth_element_##SUFFIX(T *arr, int n, int k) {                     \
+    int lo = 0, hi = n, depth = 0;                                             \
+    for (int m = n; m > 1; m >>= 1)                                            \
+      depth += 2;                                                              \
+    while (hi - lo > INTRO_CUTOFF) {                                           \
+      if (depth-- == 0) {                                                      \
+        heap_sort_##SUFFIX(arr + lo, hi - lo);                                 \
+        return;                                                                \
+      }                                                                        \
+      int lt, gt;                                                              \
+      partition3_##SUFFIX(arr, lo, hi, &lt, &gt);                              \
+      if (k < lt)                                                              \
+        hi = lt;                                                               \
+      else if (k > gt)                                                         \
+        lo = gt + 1;                                                           \
+      else                                                                     \
+        return;                                                                \
+    }                                                                          \
+    intro_insertion_##SUFFIX(arr + lo, hi - lo);                               \
+  }                                                                            \
+  /* Heap top-k: arr[0..k) is a max-heap of the k first elements seen (root    \
+     = the last one kept); a later element placed before the root replaces     \
+     it. O(n log k), then the heap is sorted in place */                       \
+  static void top_k_##SUFFIX(T *arr, int n, int k) {                           \
+    for (int i = k / 2 - 1; i >= 0; i--)                                       \
+      sift_down_##SUFFIX(arr, i, k);                                           \
+    for (int i = k; i < n; i++)                                                \
+      if (OUT_OF_ORDER(arr[0], arr[i])) {                                      \
+        T t = arr[0];                                                          \
+        arr[0] = arr[i];                                                       \
+        arr[i] = t;                                                            \
+        SORT_OP_SWAP();                                                        \
+        sift_down_##SUFFIX(arr, 0, k);                                         \
+      }                                                                        \
+    heap_sort_##SUFFIX(arr, k);                                                \
+  }                                                                            \
+  /* Partial quicksort: a part entirely before k is sorted by Introsort, a     \
+     part entirely from k on is left alone */                                  \
+  static void partial_quick_##SUFFIX(T *arr, int n, int k) {                   \
+    int lo = 0, hi = n, depth = 0;                                             \
+    for (int m = n; m > 1; m >>= 1)                                            \
+      depth += 2;                                                              \
+    while (hi - lo > INTRO_CUTOFF) {                                           \
+      if (depth-- == 0) {                                                      \
+        top_k_##SUFFIX(arr + lo, hi - lo, k - lo);                             \
+        return;                                                                \
+      }                                                                        \
+      int lt, gt;                                                              \
+      partition3_##SUFFIX(arr, lo, hi, &lt, &gt);                              \
+      if (k <= lt) {                                                           \
+        hi = lt;                                                               \
+        continue;                                                              \
+      }                                                                        \
+      intro_loop_##SUFFIX(arr, lo, lt, depth);                                 \
+      if (k <= gt + 1)                                                         \
+        return;                                                                \
+      lo = gt + 1;                                                             \
+    }                                                                          \
+    intro_insertion_##SUFFIX(arr + lo, hi - lo);                               \
+  }                                                                            \
+  /* mode: a SelectMode (typed_sort.h) */                                      \
+  static void select_##SUFFIX(T *arr, int n, int k, int mode) {                \
+    if (k <= 0 || n <= 0)                                                      \
+      return;                                                                  \
+    if (k > n)                                                                 \
+      k = n;                                                                   \
+    if (mode == SELECT_NTH)                                                    \
+      nth_element_##SUFFIX(arr, n, k - 1);                                     \
+    else if (mode == SELECT_TOP_K)                                             \
+      top_k_##SUFFIX(arr, n, k);                                               \
+    else                                                                       \
+      partial_quick_##SUFFIX(arr, n, k);                                       \
+  }
+
+// TimSort: natural runs (strictly descending ones reversed) are extended to
+// a minimum length by binary insertion, pushed on a stack and merged so run
+// lengths keep decreasing geometrically; merges switch to galloping
+// (exponential then binary search) while one run keeps winning. Stable,
+// O(n) on sorted input, O(n log n) in the worst case, n / 2 extra elements.
+#define TIM_MIN_MERGE 32
+#define TIM_MIN_GALLOP 7
+#define TIM_MAX_RUNS 64
+
+#define DEFINE_TIMSORT(SUFFIX, T, OUT_OF_ORDER)                                \
+  struct tim_##SUFFIX {                                                        \
+    T *arr;                                                                    \
+    T *tmp; /* n / 2 elements: the shorter run of a merge */                   \
+    int min_gallop;                                                            \
+    int n_runs;                                                                \
+    int base[TIM_MAX_RUNS], len[TIM_MAX_RUNS];                                 \
+  };                                                                           \
+  /* Leftmost k with a[k - 1] < key <= a[k], searched from a[hint] */          \
+  static int tim_gallop_left_##SUFFIX(T key, T *a, int n, int hint) {          \
+    int last = 0, ofs = 1;                                                     \
+    if (OUT_OF_ORDER(key, a[hint])) {                                          \
+      int max = n - hint;                                                      \
+      while (ofs < max && OUT_OF_ORDER(key, a[hint + ofs])) {                  \
+        last = ofs;                                                            \
+        ofs = ofs < max / 2 ? 2 * ofs + 1 : max;                               \
+      }                                                                        \
+      if (ofs > max)                                                           \
+        ofs = max;                                                             \
+      last += hint;                                                            \
+      ofs += hint;                                                             \
+    } else {                                                                   \
+      int max = hint + 1;                                                      \
+      while (ofs < max && !OUT_OF_ORDER(key, a[hint - ofs])) {                 \
+        last = ofs;                                                            \
+        ofs = ofs < max / 2 ? 2 * ofs + 1 : max;                               \
+      }                                                                        \
+      if (ofs > max)                                                           \
+        ofs = max;                                                             \
+      int t = last;                                                            \
+      last = hint - ofs;                                                       \
+      ofs = hint - t;                                                          \
+    }                                                                          \
+    for (last++; last < ofs;) {                                                \
+      int mid = last + (ofs - last) / 2;                                       \
+      if (OUT_OF_ORDER(key, a[mid]))                                           \
+        last = mid + 1;                                                        \
+      else                                                                     \
+        ofs = mid;                                                             \
+    }                                                                          \
+    return ofs;                                                                \
+  }                                                                            \
+  /* Rightmost k with a[k - 1] <= key < a[k], searched from a[hint] */         \
+  static int tim_gallop_right_##SUFFIX(T key, T *a, int n, int hint) {         \
+    int last = 0, ofs = 1;                                                     \
+    if (OUT_OF_ORDER(a[hint], key)) {                                          \
+      int max = hint + 1;                                                      \
+      while (ofs < max && OUT_OF_ORDER(a[hint - ofs], key)) {                  \
+        last = ofs;                                                            \
+        ofs = ofs < max / 2 ? 2 * ofs + 1 : max;                               \
+      }                                                                        \
+      if (ofs > max)                                                           \
+        ofs = max;                                                             \
+      int t = last;                                                            \
+      last = hint - ofs;                                                       \
+      ofs = hint - t;                                                          \
+    } else {                                                                   \
+      int max = n - hint;                                                      \
+      while (ofs < max && !OUT_OF_ORDER(a[hint + ofs], key)) {                 \
+        last = ofs;                                                            \
+        ofs = ofs < max / 2 ? 2 * ofs + 1 : max;                               \
+      }                                                                        \
+      if (ofs > max)                                                           \
+        ofs = max;                                                             \
+      last += hint;                                                            \
+      ofs += hint;                                                             \
+    }                                                                          \
+    for (last++; last < ofs;) {                                                \
+      int mid = last + (ofs - last) / 2;                                       \
+      if (OUT_OF_ORDER(a[mid], key))                                           \
+        ofs = mid;                                                             \
+      else                                                                     \
+        last = mid + 1;                                                        \
+    }                                                                          \
+    return ofs;                                                                \
+  }                                                                            \
+  /* Length of the run at a[0..n), reversed in place if strictly               \
+     descending (strict so equal elements keep their order) */                 \
+  static int tim_count_run_##SUFFIX(T *a, int n) {                             \
+    int hi = 1;                                                                \
+    if (n == 1)                                                                \
+      return 1;                                                                \
+    if (OUT_OF_ORDER(a[0], a[hi++])) {                                         \
+      while (hi < n && OUT_OF_ORDER(a[hi - 1], a[hi]))                         \
+        hi++;                                                                  \
+      for (int i = 0, j = hi - 1; i < j; i++, j--) {                           \
+        T t = a[i];                                                            \
+        a[i] = a[j];                                                           \
+        a[j] = t;                                                              \
+        SORT_OP_SWAP();                                                        \
+      }                                                                        \
+    } else {                                                                   \
+      while (hi < n && !OUT_OF_ORDER(a[hi - 1], a[hi]))                        \
+        hi++;                                                                  \
+    }                                                                          \
+    return hi;                                                                 \
+  }                                                                            \
+  /* a[0..start) is sorted: binary insertion of the rest */                    \
+  static void tim_binary_insertion_##SUFFIX(T *a, int n, int start) {          \
+    for (; start < n; start++) {                                               \
+      T pivot = a[start];                                                      \
+      int lo = 0, hi = start;                                                  \
+      while (lo < hi) {                                                        \
+        int mid = lo + (hi - lo) / 2;                                          \
+        if (OUT_OF_ORDER(a[mid], pivot))                                       \
+          hi = mid;                                                            \
+        else                                                                   \
+          lo = mid + 1;                                                        \
+      }                                                                        \
+      memmove(a + lo + 1, a + lo, (start - lo) * sizeof(T));                   \
+      SORT_OP_MOVES(start - lo);                                               \
+      a[lo] = pivot;                                                           \
+      SORT_OP_MOVE();                                                          \
+    }                                                                          \
+  }                                                                            \
+  /* Merges a1[0..n1) with the following a2[0..n2) when n1 <= n2: a1 goes      \
+     to tmp and the output is written from the left */                         \
+  static void tim_merge_lo_##SUFFIX(struct tim_##SUFFIX *ts, T *a1, int n1,    \
+                                    T *a2, int n2) {                           \
+    T *tmp = ts->tmp;                                                          \
+    T *dest = a1;                                                              \
+    memcpy(tmp, a1, n1 * sizeof(T));                                           \
+    SORT_OP_MOVES(n1);                                                         \
+    *dest++ = *a2++;                                                           \
+    SORT_OP_MOVE();                                                            \
+    if (--n2 == 0)                                                             \
+      goto done;                                                               \
+    if (n1 == 1)                                                               \
+      goto done;                                                               \
+    int min_gallop = ts->min_gallop;                                           \
+    for (;;) {                                                                 \
+      int c1 = 0, c2 = 0; /* Consecutive wins of each run */                   \
+      do {                                                                     \
+        SORT_OP_MOVE();                                                        \
+        if (OUT_OF_ORDER(*tmp, *a2)) {                                         \
+          *dest++ = *a2++;                                                     \
+          c2++;                                                                \
+          c1 = 0;                                                              \
+          if (--n2 == 0)                                                       \
+            goto out;                                                          \
+        } else {                                                               \
+          *dest++ = *tmp++;                                                    \
+          c1++;                                                                \
+          c2 = 0;                                                              \
+          if (--n1 == 1)                                                       \
+            goto out;                                                          \
+        }                                                                      \
+      } while ((c1 | c2) < min_gallop);                                        \
+      /* One run keeps winning: copy whole blocks found by galloping */        \
+      do {                                                                     \
+        c1 = tim_gallop_right_##SUFFIX(*a2, tmp, n1, 0);                       \
+        if (c1) {                                                              \
+          memcpy(dest, tmp, c1 * sizeof(T));                                   \
+          SORT_OP_MOVES(c1);                                                   \
+          dest += c1;                                                          \
+          tmp += c1;                                                           \
+          n1 -= c1;                                                            \
+          if (n1 <= 1)                                                         \
+            goto out;                                                          \
+        }                                                                      \
+        *dest++ = *a2++;                                                       \
+        SORT_OP_MOVE();                                                        \
+        if (--n2 == 0)                                                         \
+          goto out;                                                            \
+        c2 = tim_gallop_left_##SUFFIX(*tmp, a2, n2, 0);                        \
+        if (c2) {                                                              \
+          memmove(dest, a2, c2 * sizeof(T));                                   \
+          SORT_OP_MOVES(c2);                                                   \
+          dest += c2;                                                          \
+          a2 += c2;                                                            \
+          n2 -= c2;                                                            \
+          if (n2 == 0)                                                         \
+            goto out;                                                          \
+        }                                                                      \
+        *dest++ = *tmp++;                                                      \
+        SORT_OP_MOVE();                                                        \
+        if (--n1 == 1)                                                         \
+          goto out;                                                            \
+        min_gallop--;                                                          \
+      } while (c1 >= TIM_MIN_GALLOP || c2 >= TIM_MIN_GALLOP);                  \
+      if (min_gallop < 0)                                                      \
+        min_gallop = 0;                                                        \
+      min_gallop += 2; /* Leaving gallop mode costs more next time */          \
+    }                                                                          \
+  out:                                                                         \
+    ts->min_gallop = min_gallop < 1 ? 1 : min_gallop;                          \
+  done:                                                                        \
+    if (n1 == 1) { /* Rest of run 2, then the last element of run 1 */         \
+      memmove(dest, a2, n2 * sizeof(T));                                       \
+      SORT_OP_MOVES(n2);                                                       \
+      dest[n2] = *tmp;                                                         \
+      SORT_OP_MOVE();                                                          \
+    } else if (n1 > 0) {                                                       \
+      memcpy(dest, tmp, n1 * sizeof(T));                                       \
+      SORT_OP_MOVES(n1);                                                       \
+    }                                                                          \
+  }                                                                            \
+  /* Mirror of merge_lo when n1 > n2: a2 goes to tmp and the output is         \
+     written from the right */                                                 \
+  static void tim_merge_hi_##SUFFIX(struct tim_##SUFFIX *ts, T *a1, int n1,    \
+                                    T *a2, int n2) {                           \
+    T *tmp = ts->tmp;                                                          \
+    memcpy(tmp, a2, n2 * sizeof(T));                                           \
+    SORT_OP_MOVES(n2);                                                         \
+    T *c1p = a1 + n1 - 1; /* Cursors on run 1, tmp (run 2) and output */       \
+    T *c2p = tmp + n2 - 1;                                                     \
+    T *dest = a2 + n2 - 1;                                                     \
+    *dest-- = *c1p--;                                                          \
+    SORT_OP_MOVE();                                                            \
+    if (--n1 == 0)                                                             \
+      goto done;                                                               \
+    if (n2 == 1)                                                               \
+      goto done;                                                               \
+    int min_gallop = ts->min_gallop;                                           \
+    for (;;) {                                                                 \
+      int c1 = 0, c2 = 0;                                                      \
+      do {                                                                     \
+        SORT_OP_MOVE();                                                        \
+        if (OUT_OF_ORDER(*c1p, *c2p)) {                                        \
+          *dest-- = *c1p--;                                                    \
+          c1++;                                                                \
+          c2 = 0;                                                              \
+          if (--n1 == 0)                                                       \
+            goto out;                                                          \
+        } else {                                                               \
+          *dest-- = *c2p--;                                                    \
+          c2++;                                                                \
+          c1 = 0;                                                              \
+          if (--n2 == 1)                                                       \
+            goto out;                                                          \
+        }                                                                      \
+      } while ((c1 | c2) < min_gallop);                                        \
+      do {                                                                     \
+        c1 = n1 - tim_gallop_right_##SUFFIX(*c2p, a1, n1, n1 - 1);             \
+        if (c1) {                                                              \
+          dest -= c1;                                                          \
+          c1p -= c1;                                                           \
+          n1 -= c1;                                                            \
+          memmove(dest + 1, c1p + 1, c1 * sizeof(T));                          \
+          SORT_OP_MOVES(c1);                                                   \
+          if (n1 == 0)                                                         \
+            goto out;                                                          \
+        }                                                                      \
+        *dest-- = *c2p--;                                                      \
+        SORT_OP_MOVE();                                                        \
+        if (--n2 == 1)                                                         \
+          goto out;                                                            \
+        c2 = n2 - tim_gallop_left_##SUFFIX(*c1p, tmp, n2, n2 - 1);             \
+        if (c2) {                                                              \
+          dest -= c2;                                                          \
+          c2p -= c2;                                                           \
+          n2 -= c2;                                                            \
+          memcpy(dest + 1, c2p + 1, c2 * sizeof(T));                           \
+          SORT_OP_MOVES(c2);                                                   \
+          if (n2 <= 1)                                                         \
+            goto out;                                                          \
+        }                                                                      \
+        *dest-- = *c1p--;                                                      \
+        SORT_OP_MOVE();                                                        \
+        if (--n1 == 0)                                                         \
+          goto out;                                                            \
+        min_gallop--;                                                          \
+      } while (c1 >= TIM_MIN_GALLOP || c2 >= TIM_MIN_GALLOP);                  \
+      if (min_gallop < 0)                                                      \
+        min_gallop = 0;                                                        \
+      min_gallop += 2;                                                         \
+    }                                                                          \
+  out:                                                                         \
+    ts->min_gallop = min_gallop < 1 ? 1 : min_gallop;                          \
+  done:                                                                        \
+    if (n2 == 1) { /* Rest of run 1, then the first element of run 2 */        \
+      dest -= n1;                                                              \
+      c1p -= n1;                                                               \
+      memmove(dest + 1, c1p + 1, n1 * sizeof(T));                              \
+      SORT_OP_MOVES(n1);                                                       \
+      *dest = *c2p;                                                            \
+      SORT_OP_MOVE();                                                          \
+    } else if (n2 > 0) {                                                       \
+      memcpy(dest - (n2 - 1), tmp, n2 * sizeof(T));                            \
+      SORT_OP_MOVES(n2);                                                       \
+    }                                                                          \
+  }                                                                            \
+  /* Merges runs i and i + 1 of the stack */                                   \
+  static void tim_merge_at_##SUFFIX(struct tim_##SUFFIX *ts, int i) {          \
+    T *a1 = ts->arr + ts->base[i];                                             \
+    T *a2 = ts->arr + ts->base[i + 1];                                         \
+    int n1 = ts->len[i], n2 = ts->len[i + 1];                                  \
+    ts->len[i] = n1 + n2;                                                      \
+    if (i == ts->n_runs - 3) {                                                 \
+      ts->base[i + 1] = ts->base[i + 2];                                       \
+      ts->len[i + 1] = ts->len[i + 2];                                         \
+    }                                                                          \
+    ts->n_runs--;                                                              \
+    /* Elements of run 1 already before run 2, and of run 2 already after      \
+       run 1, stay where they are */                                           \
+    int k = tim_gallop_right_##SUFFIX(*a2, a1, n1, 0);                         \
+    a1 += k;                                                                   \
+    n1 -= k;                                                                   \
+    if (n1 == 0)                                                               \
+      return;                                                                  \
+    n2 = tim_gallop_left_##SUFFIX(a1[n1 - 1], a2, n2, n2 - 1);                 \
+    if (n2 == 0)                                                               \
+      return;                                                                  \
+    if (n1 <= n2)                                                              \
+      tim_merge_lo_##SUFFIX(ts, a1, n1, a2, n2);                               \
+    else                                                                       \
+      tim_merge_hi_##SUFFIX(ts, a1, n1, a2, n2);                               \
+  }                                                                            \
+  /* Keeps run lengths decreasing faster than Fibonacci (with the fix for      \
+     the invariant checked on the top three runs only) */                      \
+  static void tim_merge_collapse_##SUFFIX(struct tim_##SUFFIX *ts) {           \
+    int *len = ts->len;                                                        \
+    while (ts->n_runs > 1) {                                                   \
+      int i = ts->n_runs - 2;                                                  \
+      if ((i > 0 && len[i - 1] <= len[i] + len[i + 1]) ||                      \
+          (i > 1 && len[i - 2] <= len[i - 1] + len[i])) {                      \
+        if (len[i - 1] < len[i + 1])                                           \
+          i--;                                                                 \
+      } else if (len[i] > len[i + 1]) {                                        \
+        break;                                                                 \
+      }                                                                        \
+      tim_merge_at_##SUFFIX(ts, i);                                            \
+    }                                                                          \
+  }                                                                            \
+  static void timsort_##SUFFIX(T *arr, int n) {                                \
+    if (n < 2)                                                                 \
+      return;                                                                  \
+    if (n < TIM_MIN_MERGE) {                                                   \
+      tim_binary_insertion_##SUFFIX(arr, n, tim_count_run_##SUFFIX(arr, n));   \
+      return;                                                                  \
+    }                                                                          \
+    struct tim_##SUFFIX ts = {.arr = arr,                                      \
+                              .tmp = malloc((n / 2 + 1) * sizeof(T)),          \
+                              .min_gallop = TIM_MIN_GALLOP};                   \
+    int min_run = n, r = 0;                                                    \
+    while (min_run >= TIM_MIN_MERGE) {                                         \
+      r |= min_run & 1;                                                        \
+      min_run >>= 1;                                                           \
+    }                                                                          \
+    min_run += r;                                                              \
+    for (int lo = 0; lo < n;) {                                                \
+      int run = tim_count_run_##SUFFIX(arr + lo, n - lo);                      \
+      if (run < min_run) { /* Short run: extended by binary insertion */       \
+        int force = n - lo < min_run ? n - lo : min_run;                       \
+        tim_binary_insertion_##SUFFIX(arr + lo, force, run);                   \
+        run = force;                                                           \
+      }                                                                        \
+      ts.base[ts.n_runs] = lo;                                                 \
+      ts.len[ts.n_runs++] = run;                                               \
+      tim_merge_collapse_##SUFFIX(&ts);                                        \
+      lo += run;                                                               \
+    }                                                                          \
+    while (ts.n_runs > 1) {                                                    \
+      int i = ts.n_runs - 2;                                                   \
+      if (i > 0 && ts.len[i - 1] < ts.len[i + 1])                              \
+        i--;                                                                   \
+      tim_merge_at_##SUFFIX(&ts, i);                                           \
+    }                                                                          \
+    free(ts.tmp);                                                              \
+  }
+
+// All the algorithms of the "Algorithme" combo plus sort_##SUFFIX(arr, n,
+// algo) dispatching on a SortAlgo (sort.h).
+#define DEFINE_SORTS(SUFFIX, T, OUT_OF_ORDER)                                  \
+  DEFINE_BUBBLE(SUFFIX, T, OUT_OF_ORDER)                                       \
+  DEFINE_INSERTION(SUFFIX, T, OUT_OF_ORDER)                                    \
+  DEFINE_SHELL(SUFFIX, T, OUT_OF_ORDER)                                        \
+  DEFINE_QUICK(SUFFIX, T, OUT_OF_ORDER)                                        \
+  DEFINE_INTROSORT(SUFFIX, T, OUT_OF_ORDER)                                    \
+  DEFINE_TIMSORT(SUFFIX, T, OUT_OF_ORDER)                                      \
+  static void sort_##SUFFIX(T *arr, int n, int algo) {                         \
+    if (algo == ALGO_BUBBLE)                                                   \
+      bubble_##SUFFIX(arr, n);                                                 \
+    else if (algo == ALGO_INSERTION)                                           \
+      insertion_##SUFFIX(arr, n);                                              \
+    else if (algo == ALGO_SHELL)                                               \
+      shell_##SUFFIX(arr, n);                                                  \
+    else if (algo == ALGO_QUICK)                                               \
+      quick_##SUFFIX(arr, 0, n - 1);                                           \
+    else if (algo == ALGO_TIM)                                                 \
+      timsort_##SUFFIX(arr, n);                                                \
+    else /* Introsort, also the fallback for non-comparison algos */           \
+      introsort_##SUFFIX(arr, n);                                              \
+  }
+
+#endif
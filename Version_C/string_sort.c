@@ -0,0 +1,131 @@
+#include "string_sort.h"
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define PREFIX_BYTES 8
+#define MKQS_CUTOFF 16 // Insertion sort below this size
+
+typedef struct {
+  uint64_t key; // Bytes depth .. depth + 7, big-endian, 0 after the NUL
+  char *s;
+} StrKey;
+
+// The last byte is 0 when the string ends inside the key: equal keys then
+// mean equal strings
+#define KEY_ENDS(k) (((k)&0xff) == 0)
+
+static uint64_t load_key(const char *s) {
+  uint64_t k = 0;
+  int i = 0;
+  for (; i < PREFIX_BYTES && s[i]; i++)
+    k = k << 8 | (unsigned char)s[i];
+  return i ? k << (8 * (PREFIX_BYTES - i)) : 0;
+}
+
+static void load_keys(StrKey *a, int n, size_t depth) {
+  for (int i = 0; i < n; i++)
+    a[i].key = load_key(a[i].s + depth);
+}
+
+static int key_less(const StrKey *a, const StrKey *b, size_t depth) {
+  if (a->key != b->key)
+    return a->key < b->key;
+  if (KEY_ENDS(a->key))
+    return 0;
+  return strcmp(a->s + depth + PREFIX_BYTES, b->s + depth + PREFIX_BYTES) < 0;
+}
+
+static void insertion(StrKey *a, int n, size_t depth) {
+  for (int i = 1; i < n; i++) {
+    StrKey v = a[i];
+    int j = i - 1;
+    while (j >= 0 && key_less(&v, &a[j], depth)) {
+      a[j + 1] = a[j];
+      j--;
+    }
+    a[j + 1] = v;
+  }
+}
+
+static uint64_t med3(uint64_t a, uint64_t b, uint64_t c) {
+  return a < b ? (b < c ? b : a < c ? c : a) : (a < c ? a : b < c ? c : b);
+}
+
+// Median of 3, or Tukey's ninther on larger parts
+static uint64_t pivot_key(const StrKey *a, int n) {
+  int m = n / 2, l = 0, r = n - 1;
+  if (n >= 64) {
+    int d = n / 8;
+    return med3(med3(a[l].key, a[l + d].key, a[l + 2 * d].key),
+                med3(a[m - d].key, a[m].key, a[m + d].key),
+                med3(a[r - 2 * d].key, a[r - d].key, a[r].key));
+  }
+  return med3(a[l].key, a[m].key, a[r].key);
+}
+
+static void swap_key(StrKey *a, StrKey *b) {
+  StrKey t = *a;
+  *a = *b;
+  *b = t;
+}
+
+static void mkqs(StrKey *a, int n, size_t depth) {
+  while (n > MKQS_CUTOFF) {
+    uint64_t pivot = pivot_key(a, n);
+
+    // Three-way partition: [0, lt) < pivot, [lt, gt] == pivot, (gt, n) >
+    int lt = 0, i = 0, gt = n - 1;
+    while (i <= gt) {
+      if (a[i].key < pivot)
+        swap_key(&a[lt++], &a[i++]);
+      else if (a[i].key > pivot)
+        swap_key(&a[i], &a[gt--]);
+      else
+        i++;
+    }
+
+    StrKey *eq = a + lt, *hi = a + gt + 1;
+    int n_lt = lt, n_eq = gt + 1 - lt, n_hi = n - gt - 1;
+    if (KEY_ENDS(pivot))
+      n_eq = 0; // Identical strings: already in place
+    else
+      load_keys(eq, n_eq, depth + PREFIX_BYTES);
+
+    // Recurse into the two smaller parts and loop on the largest, so the
+    // stack stays O(log n)
+    if (n_eq >= n_lt && n_eq >= n_hi) {
+      mkqs(a, n_lt, depth);
+      mkqs(hi, n_hi, depth);
+      a = eq;
+      n = n_eq;
+      depth += PREFIX_BYTES;
+    } else if (n_lt >= n_hi) {
+      mkqs(eq, n_eq, depth + PREFIX_BYTES);
+      mkqs(hi, n_hi, depth);
+      n = n_lt;
+    } else {
+      mkqs(a, n_lt, depth);
+      mkqs(eq, n_eq, depth + PREFIX_BYTES);
+      a = hi;
+      n = n_hi;
+    }
+  }
+  insertion(a, n, depth);
+}
+
+void string_sort(char **strs, int n, int descending) {
+  if (n < 2)
+    return;
+  StrKey *a = malloc(n * sizeof(StrKey));
+  for (int i = 0; i < n; i++)
+    a[i].s = strs[i];
+  load_keys(a, n, 0);
+
+  mkqs(a, n, 0);
+
+  // Equal strings are interchangeable, so reversing gives descending order
+  for (int i = 0; i < n; i++)
+    strs[i] = a[descending ? n - 1 - i : i].s;
+  free(a);
+}
@@ -0,0 +1,13 @@
+#ifndef STRING_SORT_H
+#define STRING_SORT_H
+
+// Multikey quicksort (Bentley-Sedgewick three-way radix quicksort) for NUL
+// terminated strings. The next 8 bytes of every string are cached in a
+// 64-bit key next to its pointer, so partitioning compares integers and only
+// groups sharing those 8 bytes go back to the strings for the following 8.
+// Same order as strcmp. No GTK dependency.
+
+// Sorts the pointers; the strings themselves are not moved
+void string_sort(char **strs, int n, int descending);
+
+#endif
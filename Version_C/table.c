@@ -1,54 +1,143 @@
 #include "app.h"
+#include "bench.h"
+#include "bench_io.h"
+#include "external_sort.h"
+#include "op_count.h"
+#include "parallel_sort.h"
+#include "rng.h"
+#include "shell_gaps.h"
+#include "simd_sort.h"
+#include "sort.h"
+#include "typed_io.h"
+#include "typed_sort.h"
+#include "typed_view.h"
 #include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
 #include <string.h>
 #include <time.h>
 
 // Generic Data Wrapper
-typedef enum { TYPE_INT, TYPE_DOUBLE, TYPE_CHAR, TYPE_STRING } DataType;
 static DataType current_dtype = TYPE_INT;
 
-// Data for Text Views
-static void **data_array = NULL;
-static int data_size = 0;
+// Data for Text Views (contiguous; boxed only while running the baseline)
+static TypedArray data_typed;
+static TypedArray data_before; // Unsorted copy, taken on the first sort
+static TypedArray data_demo;   // Sorted copy shown by "Comparer"
+static Arena box_arena;        // Boxes of the "void** (arene)" storage
+
+// Storage combo entries
+enum { STORAGE_TYPED, STORAGE_BOXED, STORAGE_BOXED_ARENA };
 
 // Benchmarking State
-static double *perf_times[4];
-static int perf_samples = 4;
-static int perf_benchmark_max_n = 2000;
+static double *perf_times[SORT_KERNEL_MAX]; // Median of the timed runs
+static double *perf_min[SORT_KERNEL_MAX];   // Error bar: min .. p95
+static double *perf_p95[SORT_KERNEL_MAX];
+static double *perf_boxed[SORT_KERNEL_MAX]; // Same runs on void** (dashed)
+static BenchStats *perf_stats[SORT_KERNEL_MAX]; // All statistics (export)
+static PerfSample *perf_hw[SORT_KERNEL_MAX];    // Counters per sample
+static SortOps *perf_ops[SORT_KERNEL_MAX];    // Counting run per sample
+static gboolean perf_have_ops = FALSE;        // Last job filled perf_ops
+static int perf_done[SORT_KERNEL_MAX]; // Samples already measured per algorithm
+static gboolean perf_show_boxed = FALSE;
+
+// Scaling run: parallel sort at fixed N for 1..max threads
+static gboolean graph_scaling = FALSE; // draw_viz shows speedup vs threads
+static int scale_threads[PAR_MAX_THREADS];
+static double scale_ms[PAR_MAX_THREADS];
+static int scale_count = 0;
+static int scale_done = 0;
+static int scale_n = 0;
+
+// "Comparer" sweep: linear (4 sizes up to N) or geometric (log-log graph)
+#define PERF_MAX_SAMPLES 64
+#define PERF_SKIP_MS 250.0 // Geometric sweep: stop an algorithm past this
+static int perf_n[PERF_MAX_SAMPLES]; // Sizes of the sweep, increasing
+static int perf_samples = 0;
+static gboolean perf_log_axes = FALSE;
+
+// Baseline loaded from an export: overlaid on the time graph, the points
+// slower than it by more than the "Seuil" percentage are circled in red
+static BenchRecord *baseline = NULL;
+static int baseline_count = 0;
+static char *baseline_name = NULL; // File name, for the summary
 
 // UI Widgets
 static GtkWidget *entry_size;
 static GtkWidget *combo_type;
+static GtkWidget *combo_dist;
+static GtkWidget *spin_disorder;
+static GtkWidget *spin_seed; // Dataset seed, 0 draws a new one
+static GtkWidget *combo_select;
+static GtkWidget *spin_k;
 static GtkWidget *combo_algo;
-static GtkWidget *text_before;
+static GtkWidget *combo_storage;
+static GtkWidget *check_boxed_graph;
+static GtkWidget *combo_metric; // Graph Y axis: time or an operation count
+static GtkWidget *text_before; // typed_view.c list views
 static GtkWidget *text_after;
 static GtkWidget *label_stats;
 static GtkWidget *drawing_area;
 static GtkWidget *radio_asc;
 static GtkWidget *radio_desc;
+static GtkWidget *btn_compare;
+static GtkWidget *btn_scaling;
+static GtkWidget *spin_threads;
+static GtkWidget *combo_gaps; // Shell sort gap sequence
+static GtkWidget *btn_gaps;
+static GtkWidget *spin_warmup;
+static GtkWidget *spin_repeats;
+static GtkWidget *check_counters;
+static GtkWidget *combo_sweep;
+static GtkWidget *spin_sweep_lo; // Geometric sweep: 2^lo .. 2^hi
+static GtkWidget *spin_sweep_hi;
+static GtkWidget *spin_sweep_steps; // Sizes per doubling
+static GtkWidget *spin_regress;     // Regression threshold (%)
+static GtkWidget *btn_cancel;
+static GtkWidget *progress_bench;
+static GtkWidget *spin_ext_mem;
+static GtkWidget *btn_ext_sort;
 
 static gboolean graph_ready = FALSE;
 
 // --- Helper Functions ---
 
+// Random swaps applied to "Presque trie" input of n items: the presortedness
+// set by spin_disorder (percentage of n)
+static int disorder_swaps(double fraction, int n) {
+  return (int)(fraction * n + 0.5);
+}
+
+// Seed of the next dataset: the "Graine" value, or a new one when it is 0.
+// Reported with the results so that a run can be repeated exactly.
+static unsigned int dataset_seed(void) {
+  return rng_seed_or_fresh(
+      (unsigned int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(spin_seed)));
+}
+
+// The views point into these arrays: they are emptied first
 static void free_data() {
-  if (!data_array)
-    return;
-  for (int i = 0; i < data_size; i++) {
-    if (data_array[i])
-      free(data_array[i]);
-  }
-  free(data_array);
-  data_array = NULL;
-  data_size = 0;
+  typed_view_set(text_before, NULL);
+  typed_view_set(text_after, NULL);
+  typed_array_free(&data_typed);
+  typed_array_free(&data_before);
+  typed_array_free(&data_demo);
 }
 
-static char *rand_string(int len) {
-  char *s = malloc(len + 1);
-  for (int i = 0; i < len; i++)
-    s[i] = 'a' + rand() % 26;
-  s[len] = '\0';
-  return s;
+// New data_typed (generated or loaded): shown as is, nothing sorted yet
+static void show_new_data(void) {
+  typed_array_free(&data_before);
+  typed_array_free(&data_demo);
+  typed_view_set(text_before, &data_typed);
+  typed_view_set(text_after, NULL);
+}
+
+// Key k in [0, 26^len) written as len letters, so string order follows k
+static void key_string(char *s, int len, int k) {
+  for (int i = len - 1; i >= 0; i--) {
+    s[i] = 'a' + k % 26;
+    k /= 26;
+  }
 }
 
 // Comparator for Generic Data
@@ -63,6 +152,7 @@ static int cmp_generic(const void *a, const void *b) {
     res = *(char *)a - *(char *)b;
   else
     res = strcmp((char *)a, (char *)b);
+  GENERIC_OP(cmp);
 
   if (gtk_check_button_get_active(GTK_CHECK_BUTTON(radio_desc)))
     return -res;
@@ -76,10 +166,21 @@ static int cmp_ptr_wrapper(const void *a, const void *b) {
 
 // --- VISIBLE GENERIC SORTS (For Text View) ---
 
+// Entry point for the void** path: type and direction are resolved once per
+// call, then a kernel with the comparison inlined does the work.
+static void sort_generic(void **arr, int n, int algo) {
+  int desc = gtk_check_button_get_active(GTK_CHECK_BUTTON(radio_desc));
+  boxed_sort(arr, n, current_dtype, algo, desc);
+}
+
+// Reference versions below go through cmp_generic on every comparison (type
+// branch + GTK lookup). Only kept to log the cost of that design.
+
 static void swap_ptr(void **a, void **b) {
   void *temp = *a;
   *a = *b;
   *b = temp;
+  GENERIC_OP(swaps);
 }
 
 // 1. Bubble Generic
@@ -98,21 +199,29 @@ static void insertion_sort_generic(void **arr, int n) {
     // Move elements of arr[0..i-1], that are greater than key
     while (j >= 0 && cmp_generic(arr[j], key) > 0) {
       arr[j + 1] = arr[j];
+      GENERIC_OP(moves);
       j = j - 1;
     }
     arr[j + 1] = key;
+    GENERIC_OP(moves);
   }
 }
 
 // 3. Shell Generic
 static void shell_sort_generic(void **arr, int n) {
-  for (int gap = n / 2; gap > 0; gap /= 2) {
+  int gaps[SHELL_MAX_GAPS];
+  int count = shell_gaps(shell_get_gaps(), n, gaps);
+  for (int g = 0; g < count; g++) {
+    int gap = gaps[g];
     for (int i = gap; i < n; i++) {
       void *temp = arr[i];
       int j;
-      for (j = i; j >= gap && cmp_generic(arr[j - gap], temp) > 0; j -= gap)
+      for (j = i; j >= gap && cmp_generic(arr[j - gap], temp) > 0; j -= gap) {
         arr[j] = arr[j - gap];
+        GENERIC_OP(moves);
+      }
       arr[j] = temp;
+      GENERIC_OP(moves);
     }
   }
 }
@@ -138,154 +247,804 @@ static void quick_sort_generic(void **arr, int low, int high) {
   }
 }
 
-static void generate_text_data(int n) {
+// Integer keys come from bench_generate so every type follows the selected
+// distribution; the range keeps the mapping to each type order-preserving.
+// Release of the old data and allocation of the new are timed apart from the
+// fill (ms[0] release, ms[1] allocation, ms[2] fill).
+static void generate_text_data(int n, BenchDist dist, unsigned int seed,
+                               double ms[3]) {
+  gint64 t0 = g_get_monotonic_time();
   free_data();
-  data_size = n;
-  data_array = malloc(n * sizeof(void *));
+  gint64 t1 = g_get_monotonic_time();
+  typed_array_alloc(&data_typed, current_dtype, n, 4);
+  gint64 t2 = g_get_monotonic_time();
+
+  int range = current_dtype == TYPE_CHAR     ? 26
+              : current_dtype == TYPE_STRING ? 26 * 26 * 26 * 26
+                                             : 10000;
+  int *keys = malloc(n * sizeof(int));
+  double fraction =
+      gtk_spin_button_get_value(GTK_SPIN_BUTTON(spin_disorder)) / 100.0;
+  bench_generate(keys, n, dist, seed, range, disorder_swaps(fraction, n));
 
   for (int i = 0; i < n; i++) {
-    if (current_dtype == TYPE_INT) {
-      int *v = malloc(sizeof(int));
-      *v = rand() % 10000;
-      data_array[i] = v;
-    } else if (current_dtype == TYPE_DOUBLE) {
-      double *v = malloc(sizeof(double));
-      *v = (double)(rand() % 10000) / 100.0;
-      data_array[i] = v;
-    } else if (current_dtype == TYPE_CHAR) {
-      char *v = malloc(sizeof(char));
-      *v = 'A' + rand() % 26;
-      data_array[i] = v;
-    } else {
-      data_array[i] = rand_string(4);
-    }
-  }
-}
-
-static void update_text_view(GtkWidget *view, void **arr, int n) {
-  GtkTextBuffer *buf = gtk_text_view_get_buffer(GTK_TEXT_VIEW(view));
-  GString *s = g_string_new("");
-  int limit = (n > 500) ? 500 : n;
-
-  for (int i = 0; i < limit; i++) {
-    if (i > 0)
-      g_string_append(s, ", ");
     if (current_dtype == TYPE_INT)
-      g_string_append_printf(s, "%d", *(int *)arr[i]);
+      data_typed.ints[i] = keys[i];
     else if (current_dtype == TYPE_DOUBLE)
-      g_string_append_printf(s, "%.1f", *(double *)arr[i]);
+      data_typed.doubles[i] = (double)keys[i] / 100.0;
     else if (current_dtype == TYPE_CHAR)
-      g_string_append_printf(s, "'%c'", *(char *)arr[i]);
+      data_typed.chars[i] = 'A' + keys[i];
     else
-      g_string_append_printf(s, "\"%s\"", (char *)arr[i]);
+      key_string(data_typed.strs[i], 4, keys[i]);
   }
-  if (n > limit)
-    g_string_append_printf(s, " ... (+%d)", n - limit);
+  free(keys);
+  gint64 t3 = g_get_monotonic_time();
 
-  gtk_text_buffer_set_text(buf, s->str, -1);
-  g_string_free(s, TRUE);
+  ms[0] = (t1 - t0) / 1000.0;
+  ms[1] = (t2 - t1) / 1000.0;
+  ms[2] = (t3 - t2) / 1000.0;
 }
 
-// --- Benchmark Algos (Int Only for Graph speed) ---
-static void swap_int(int *a, int *b) {
-  int t = *a;
-  *a = *b;
-  *b = t;
-}
-
-static void bubble_bench(int *arr, int n) {
-  for (int k = 0; k < n - 1; k++)
-    for (int l = 0; l < n - k - 1; l++)
-      if (arr[l] > arr[l + 1])
-        swap_int(&arr[l], &arr[l + 1]);
-}
-static void insertion_bench(int *arr, int n) {
-  for (int k = 1; k < n; k++) {
-    int key = arr[k];
-    int l = k - 1;
-    while (l >= 0 && arr[l] > key) {
-      arr[l + 1] = arr[l];
-      l--;
-    }
-    arr[l + 1] = key;
+// --- Benchmark Worker ---
+// The benchmark runs on a GThread; every measurement is sent back to the GTK
+// main loop with g_idle_add so perf_times is only ever touched by the UI.
+
+typedef struct {
+  int max_n;
+  int samples;
+  int sizes[PERF_MAX_SAMPLES]; // N of each sample (not for scaling runs)
+  double skip_ms; // Drop an algorithm once its median exceeds this (0: never)
+  BenchDist dist;
+  double disorder; // Fraction of n swapped for DIST_NEARLY_SORTED
+  int warmup;  // Untimed runs before each measurement
+  int repeats; // Timed runs, summarised by bench_stats
+  unsigned int seed;
+  gboolean with_boxed; // Also time the void** baseline on the same input
+  gboolean with_counters; // One extra run per point under perf_event
+  gboolean with_ops;      // One extra counting run per point (op_count.c)
+  gboolean scaling;    // Parallel sort of max_n items, one sample per
+                       // entry of threads
+  int threads[PAR_MAX_THREADS]; // Sweep: threads[0] for the parallel kernel
+  gboolean gaps;       // Shell sort of data with every gap sequence instead
+  TypedArray data;     // Gap comparison: copy of data_typed, owned by the job
+  gboolean descending; // Gap comparison order
+  gint cancelled; // Set by the UI, polled by the worker between kernel calls
+} BenchJob;
+
+typedef struct {
+  BenchJob *job;
+  int algo; // Gap sequence for a gap comparison; -1 when the job is over
+  int sample;
+  BenchStats st;
+  double boxed_ms; // Median, -1 without a boxed version
+  PerfSample hw;   // valid == 0 without counters
+  SortOps ops;     // Only with job->with_ops
+} BenchUpdate;
+
+// Job feeding the graph, NULL when idle. A cancelled job stays here until
+// its worker's last update: only one worker ever runs.
+static BenchJob *bench_job = NULL;
+static BenchJob perf_params;       // Settings of the last sweep (export)
+
+// The kernels read the thread count and gap sequence from globals, and the
+// operation counts from a single static: nothing that sets those may run
+// while a worker does
+static void bench_controls_set_idle(gboolean idle) {
+  gtk_widget_set_sensitive(btn_compare, idle);
+  gtk_widget_set_sensitive(btn_scaling, idle);
+  gtk_widget_set_sensitive(spin_threads, idle);
+  gtk_widget_set_sensitive(combo_gaps, idle);
+  gtk_widget_set_sensitive(btn_gaps, idle);
+  gtk_widget_set_sensitive(btn_cancel, !idle);
+}
+
+static void bench_job_finished(void) {
+  bench_job = NULL;
+  bench_controls_set_idle(TRUE);
+}
+
+static void bench_job_free(BenchJob *job) {
+  typed_array_free(&job->data);
+  g_free(job);
+}
+
+// Gap comparison results, one entry per sequence done
+static double gaps_ms[GAPS_COUNT];
+static SortOps gaps_ops[GAPS_COUNT];
+static int gaps_done = 0;
+
+static void gaps_update(BenchJob *job, BenchUpdate *u) {
+  int n = job->data.n;
+  if (u->algo >= 0) {
+    gaps_ms[u->algo] = u->st.median;
+    gaps_ops[u->algo] = u->ops;
+    gaps_done = u->algo + 1;
+
+    char buf[96];
+    snprintf(buf, sizeof(buf), "Shell %s n=%d (%d/%d)",
+             shell_gaps_name(u->algo), n, gaps_done, GAPS_COUNT);
+    gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(progress_bench),
+                                  (double)gaps_done / GAPS_COUNT);
+    gtk_progress_bar_set_text(GTK_PROGRESS_BAR(progress_bench), buf);
+    return;
   }
+
+  int gaps[SHELL_MAX_GAPS];
+  GString *str = g_string_new(NULL);
+  g_string_append_printf(str, "Tri Shell, n=%d:", n);
+  for (int seq = 0; seq < gaps_done; seq++) {
+    g_string_append_printf(str, "\n%s: %.3f ms, %d ecarts",
+                           shell_gaps_name(seq), gaps_ms[seq],
+                           shell_gaps(seq, n, gaps));
+    if (job->data.type == TYPE_INT)
+      g_string_append_printf(str, ", %lld comp., %lld depl.",
+                             gaps_ops[seq].cmp, gaps_ops[seq].moves);
+  }
+  gtk_label_set_text(GTK_LABEL(label_stats), str->str);
+  g_string_free(str, TRUE);
+  gtk_progress_bar_set_text(GTK_PROGRESS_BAR(progress_bench), "Termine");
 }
-static void shell_bench(int *arr, int n) {
-  for (int gap = n / 2; gap > 0; gap /= 2) {
-    for (int k = gap; k < n; k++) {
-      int temp = arr[k];
-      int l;
-      for (l = k; l >= gap && arr[l - gap] > temp; l -= gap)
-        arr[l] = arr[l - gap];
-      arr[l] = temp;
+
+static void scaling_update(BenchJob *job, BenchUpdate *u) {
+  if (u->algo >= 0) {
+    scale_ms[u->sample] = u->st.median;
+    scale_done = u->sample + 1;
+
+    char buf[96];
+    snprintf(buf, sizeof(buf), "Parallele n=%d, %d threads (%d/%d)",
+             job->max_n, scale_threads[u->sample], scale_done, job->samples);
+    gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(progress_bench),
+                                  (double)scale_done / job->samples);
+    gtk_progress_bar_set_text(GTK_PROGRESS_BAR(progress_bench), buf);
+    return;
+  }
+
+  GString *stats_str = g_string_new("Acceleration (n fixe):");
+  for (int i = 0; i < scale_done; i++)
+    g_string_append_printf(stats_str, "\n%2d threads: %.3f ms (x%.2f)",
+                           scale_threads[i], scale_ms[i],
+                           scale_ms[0] / scale_ms[i]);
+  gtk_label_set_text(GTK_LABEL(label_stats), stats_str->str);
+  g_string_free(stats_str, TRUE);
+  gtk_progress_bar_set_text(GTK_PROGRESS_BAR(progress_bench), "Termine");
+}
+
+// Hardware counters of the largest N measured, below the timing table
+static void append_counters(GString *str) {
+  unsigned int any = 0;
+  for (int a = 0; a < sort_kernel_count; a++)
+    if (perf_done[a] > 0)
+      any |= perf_hw[a][perf_done[a] - 1].valid;
+  if (!any) {
+    g_string_append(str, "\n\nCompteurs materiels indisponibles "
+                         "(perf_event_paranoid, VM ?)");
+    return;
+  }
+
+  g_string_append(str, "\n\nCompteurs (M cycles, IPC, k br/L1/LLC/dTLB):");
+  for (int a = 0; a < sort_kernel_count; a++) {
+    if (perf_done[a] == 0)
+      continue;
+    PerfSample *hw = &perf_hw[a][perf_done[a] - 1];
+    g_string_append_printf(str, "\n%s:", sort_kernels[a].name);
+    for (int c = 0; c < PC_COUNT; c++) {
+      if (!(hw->valid & (1u << c)))
+        g_string_append(str, " -");
+      else if (c == PC_CYCLES)
+        g_string_append_printf(str, " %.2f", hw->value[c] / 1e6);
+      else if (c == PC_INSTRUCTIONS)
+        g_string_append_printf(str, " %.2f",
+                               hw->value[PC_CYCLES]
+                                   ? (double)hw->value[c] /
+                                         hw->value[PC_CYCLES]
+                                   : 0.0);
+      else
+        g_string_append_printf(str, " %.1f", hw->value[c] / 1e3);
     }
   }
+  // perf_event counts the calling thread only
+  g_string_append(str, "\n(Parallele: thread appelant seulement)");
 }
-static int partition(int *arr, int l, int h) {
-  int p = arr[h];
-  int i = (l - 1);
-  for (int j = l; j <= h - 1; j++) {
-    if (arr[j] < p) {
-      i++;
-      swap_int(&arr[i], &arr[j]);
+
+// Fit of the time curve of algorithm a, from 3 measured sizes
+static gboolean curve_fit(int a, BenchFit *fit) {
+  return perf_done[a] >= 3 &&
+         bench_fit(perf_n, perf_times[a], perf_done[a], fit);
+}
+
+// Fitted exponent of every curve, and the closer of the two models by
+// adjusted R2 (the power fit has one more free parameter)
+static void append_fits(GString *str) {
+  gboolean header = FALSE;
+  for (int a = 0; a < sort_kernel_count; a++) {
+    BenchFit fit;
+    if (!curve_fit(a, &fit))
+      continue;
+    if (!header)
+      g_string_append(str, "\n\nAjustement t = a.n^b (R2 ajuste ; R2 ajuste "
+                           "de a.n.log n):");
+    header = TRUE;
+    // With only two usable points the power fit cannot be judged
+    const char *model = isnan(fit.r2_adj)                ? "?"
+                        : fit.r2_nlogn_adj >= fit.r2_adj ? "n log n"
+                                                         : "n^b";
+    g_string_append_printf(str, "\n%s: b = %.2f (%.3f ; %.3f) -> %s",
+                           sort_kernels[a].name, fit.b, fit.r2_adj,
+                           fit.r2_nlogn_adj, model);
+  }
+}
+
+// --- Baseline ---
+
+// Baseline point of algorithm a at size n, on the distribution of the last
+// sweep; NULL if the baseline has none
+static const BenchRecord *baseline_find(int a, int n) {
+  const char *dist = bench_dist_id(perf_params.dist);
+  for (int i = 0; i < baseline_count; i++) {
+    const BenchRecord *r = &baseline[i];
+    if (r->n == n && r->st.median > 0 &&
+        strcmp(r->algo, sort_kernels[a].id) == 0 &&
+        strcmp(r->storage, "typed") == 0 && strcmp(r->dist, dist) == 0)
+      return r;
+  }
+  return NULL;
+}
+
+// Current median over the baseline one at sample s, 0 without a baseline
+static double baseline_ratio(int a, int s) {
+  const BenchRecord *r = baseline_find(a, perf_n[s]);
+  return r ? perf_times[a][s] / r->st.median : 0.0;
+}
+
+// Ratio past which a point counts as a regression
+static double regress_limit(void) {
+  return 1 + gtk_spin_button_get_value(GTK_SPIN_BUTTON(spin_regress)) / 100;
+}
+
+static void append_regressions(GString *str) {
+  if (!baseline)
+    return;
+  double limit = regress_limit();
+  int matched = 0, regressed = 0;
+  GString *list = g_string_new(NULL);
+  for (int a = 0; a < sort_kernel_count; a++)
+    for (int s = 0; s < perf_done[a]; s++) {
+      double ratio = baseline_ratio(a, s);
+      if (ratio <= 0)
+        continue;
+      matched++;
+      if (ratio > limit) {
+        regressed++;
+        g_string_append_printf(list, "\n%s n=%d: %.3f ms (ref. %.3f, +%.0f%%)",
+                               sort_kernels[a].name, perf_n[s],
+                               perf_times[a][s], perf_times[a][s] / ratio,
+                               (ratio - 1) * 100);
+      }
     }
+  g_string_append_printf(str,
+                         "\n\nReference %s: %d point(s) compare(s), "
+                         "%d regression(s) > %.0f%%",
+                         baseline_name, matched, regressed, (limit - 1) * 100);
+  g_string_append(str, list->str);
+  g_string_free(list, TRUE);
+}
+
+static gboolean bench_update_idle(gpointer data) {
+  BenchUpdate *u = data;
+  BenchJob *job = u->job;
+
+  if (g_atomic_int_get(&job->cancelled)) {
+    // Results are dropped; Compare and Scaling come back with the last
+    // update, once the worker is out of its kernel call
+    if (u->algo < 0) {
+      bench_job_finished();
+      gtk_progress_bar_set_text(GTK_PROGRESS_BAR(progress_bench), "Annule");
+      bench_job_free(job);
+    }
+    g_free(u);
+    return G_SOURCE_REMOVE;
   }
-  swap_int(&arr[i + 1], &arr[h]);
-  return (i + 1);
+
+  if (job->gaps) {
+    gaps_update(job, u);
+    if (u->algo < 0) {
+      bench_job_finished();
+      bench_job_free(job);
+    }
+    g_free(u);
+    return G_SOURCE_REMOVE;
+  }
+  if (job->scaling) {
+    scaling_update(job, u);
+    if (u->algo < 0) {
+      bench_job_finished();
+      g_free(job);
+    }
+  } else if (u->algo >= 0) {
+    perf_times[u->algo][u->sample] = u->st.median;
+    perf_min[u->algo][u->sample] = u->st.min;
+    perf_p95[u->algo][u->sample] = u->st.p95;
+    perf_stats[u->algo][u->sample] = u->st;
+    perf_hw[u->algo][u->sample] = u->hw;
+    perf_ops[u->algo][u->sample] = u->ops;
+    perf_boxed[u->algo][u->sample] = u->boxed_ms;
+    perf_done[u->algo] = u->sample + 1;
+
+    int done = u->sample * sort_kernel_count + u->algo + 1;
+    int total = job->samples * sort_kernel_count;
+    char buf[96];
+    snprintf(buf, sizeof(buf), "%s n=%d (%d/%d)", sort_kernels[u->algo].name,
+             job->sizes[u->sample], done, total);
+    gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(progress_bench),
+                                  (double)done / total);
+    gtk_progress_bar_set_text(GTK_PROGRESS_BAR(progress_bench), buf);
+  } else {
+    GString *stats_str = g_string_new(NULL);
+    g_string_printf(stats_str, "n=%d, %d mesures (ms, mediane [min-p95] s):",
+                    job->max_n, job->repeats);
+    for (int a = 0; a < sort_kernel_count; a++) {
+      int last = perf_done[a] - 1;
+      if (last < 0)
+        continue;
+      BenchStats *st = &perf_stats[a][last];
+      g_string_append_printf(stats_str, "\n%s: %.3f [%.3f-%.3f] %.3f",
+                             sort_kernels[a].name, st->median, st->min,
+                             st->p95, st->stddev);
+      if (last < job->samples - 1)
+        g_string_append_printf(stats_str, " (n=%d)", perf_n[last]);
+      if (perf_show_boxed && perf_boxed[a][last] >= 0)
+        g_string_append_printf(stats_str, " (void**: %.3f)",
+                               perf_boxed[a][last]);
+    }
+    append_fits(stats_str);
+    append_regressions(stats_str);
+    if (job->with_ops) {
+      g_string_append(stats_str, "\n\nOperations (comp. / ech. / depl.):");
+      for (int a = 0; a < sort_kernel_count; a++)
+        if (sort_ops_supported(a) && perf_done[a] > 0) {
+          SortOps *o = &perf_ops[a][perf_done[a] - 1];
+          g_string_append_printf(stats_str, "\n%s: %lld / %lld / %lld",
+                                 sort_kernels[a].name, o->cmp, o->swaps,
+                                 o->moves);
+        }
+    }
+    if (job->with_counters)
+      append_counters(stats_str);
+    gtk_label_set_text(GTK_LABEL(label_stats), stats_str->str);
+    g_string_free(stats_str, TRUE);
+
+    gtk_progress_bar_set_text(GTK_PROGRESS_BAR(progress_bench), "Termine");
+    bench_job_finished();
+    g_free(job);
+  }
+
+  gtk_widget_queue_draw(drawing_area);
+  g_free(u);
+  return G_SOURCE_REMOVE;
+}
+
+static void post_update(BenchJob *job, int algo, int sample,
+                        const BenchStats *st, double boxed_ms,
+                        const PerfSample *hw, const SortOps *ops) {
+  BenchUpdate *u = g_new0(BenchUpdate, 1);
+  u->job = job;
+  u->algo = algo;
+  u->sample = sample;
+  if (st)
+    u->st = *st;
+  u->boxed_ms = boxed_ms;
+  if (hw)
+    u->hw = *hw;
+  if (ops)
+    u->ops = *ops;
+  g_idle_add(bench_update_idle, u);
 }
-static void quick_bench(int *arr, int l, int h) {
-  if (l < h) {
-    int pi = partition(arr, l, h);
-    quick_bench(arr, l, pi - 1);
-    quick_bench(arr, pi + 1, h);
+
+static gpointer bench_worker(gpointer data) {
+  BenchJob *job = data;
+  gboolean dropped[SORT_KERNEL_MAX] = {0}; // Past job->skip_ms
+
+  int *input = malloc(job->max_n * sizeof(int));
+  int *work = malloc(job->max_n * sizeof(int));
+  double *runs = malloc(job->repeats * sizeof(double));
+  BenchStats st;
+  // Counters are per thread, so they are opened here on the worker
+  PerfCounters pc;
+  gboolean counting =
+      job->with_counters && !job->scaling && perf_counters_open(&pc) > 0;
+
+  if (job->scaling) {
+    // Same input for every thread count
+    bench_generate(input, job->max_n, job->dist, job->seed, 1000,
+                   disorder_swaps(job->disorder, job->max_n));
+    for (int s = 0; s < job->samples; s++) {
+      for (int i = 0; i < job->warmup + job->repeats; i++) {
+        if (g_atomic_int_get(&job->cancelled))
+          goto out;
+        double ms =
+            bench_time_parallel(input, work, job->max_n, job->threads[s]);
+        if (i >= job->warmup)
+          runs[i - job->warmup] = ms;
+      }
+      bench_stats(runs, job->repeats, &st);
+      post_update(job, ALGO_PARALLEL, s, &st, 0.0, NULL, NULL);
+    }
+    goto out;
+  }
+
+  for (int s = 0; s < job->samples; s++) {
+    int n = job->sizes[s];
+    // One input per size: every algorithm sorts exactly the same data
+    bench_generate(input, n, job->dist, job->seed + s, 1000,
+                   disorder_swaps(job->disorder, n));
+    for (int a = 0; a < sort_kernel_count; a++) {
+      if (g_atomic_int_get(&job->cancelled))
+        goto out;
+      if (dropped[a])
+        continue;
+      bench_measure(a, FALSE, input, work, n, job->warmup, job->repeats, &st);
+      if (job->skip_ms > 0 && st.median > job->skip_ms)
+        dropped[a] = TRUE; // Quadratic sorts stop early on a long sweep
+      double boxed_ms = 0.0;
+      if (job->with_boxed) {
+        BenchStats boxed;
+        bench_measure(a, TRUE, input, work, n, job->warmup, job->repeats,
+                      &boxed);
+        boxed_ms = boxed.runs > 0 ? boxed.median : -1;
+      }
+      PerfSample hw = {0};
+      if (counting)
+        bench_count_kernel(a, input, work, n, &pc, &hw);
+      SortOps ops = {0};
+      if (job->with_ops && sort_ops_supported(a))
+        sort_count_ops(a, input, work, n, &ops);
+      post_update(job, a, s, &st, boxed_ms, &hw, &ops);
+    }
   }
+
+out:
+  free(input);
+  free(work);
+  free(runs);
+  if (counting)
+    perf_counters_close(&pc);
+  post_update(job, -1, 0, NULL, 0.0, NULL, NULL); // UI frees the job here
+  return NULL;
 }
 
-static void run_benchmark_graph(int max_n) {
-  perf_benchmark_max_n = max_n;
-  if (!perf_times[0]) {
-    for (int a = 0; a < 4; a++)
-      perf_times[a] = malloc(perf_samples * sizeof(double));
+// Gap comparison: every sequence sorts its own copy of the job's data; ints
+// also get their operation counts. The gap setting is global, so it is
+// switched here and put back at the end (the gap controls are locked).
+static gpointer gaps_worker(gpointer data) {
+  BenchJob *job = data;
+  const TypedArray *src = &job->data;
+  int selected = shell_get_gaps();
+  int *work = src->type == TYPE_INT ? malloc(src->n * sizeof(int)) : NULL;
+
+  for (int seq = 0; seq < GAPS_COUNT; seq++) {
+    if (g_atomic_int_get(&job->cancelled))
+      break;
+    shell_set_gaps(seq);
+    TypedArray copy;
+    typed_array_copy(&copy, src);
+    gint64 start = g_get_monotonic_time();
+    typed_sort(&copy, ALGO_SHELL, job->descending);
+    BenchStats st = {0};
+    st.median = (g_get_monotonic_time() - start) / 1000.0;
+    typed_array_free(&copy);
+
+    SortOps ops = {0};
+    if (work && !g_atomic_int_get(&job->cancelled))
+      sort_count_ops(ALGO_SHELL, src->ints, work, src->n, &ops);
+    post_update(job, seq, 0, &st, 0.0, NULL, &ops);
   }
 
-  int step = perf_benchmark_max_n / perf_samples;
-  if (step < 1)
-    step = 1;
+  shell_set_gaps(selected);
+  free(work);
+  post_update(job, -1, 0, NULL, 0.0, NULL, NULL); // UI frees the job here
+  return NULL;
+}
 
-  GString *stats_str = g_string_new("Temps Final (ms):\n");
+static void start_bench_job(BenchJob *job) {
+  job->dist = gtk_combo_box_get_active(GTK_COMBO_BOX(combo_dist));
+  job->disorder =
+      gtk_spin_button_get_value(GTK_SPIN_BUTTON(spin_disorder)) / 100.0;
+  job->warmup = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spin_warmup));
+  job->repeats =
+      gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spin_repeats));
+  bench_job = job;
+  if (!job->scaling && !job->gaps)
+    perf_params = *job;
+  bench_controls_set_idle(FALSE);
+  gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(progress_bench), 0.0);
+  gtk_progress_bar_set_text(GTK_PROGRESS_BAR(progress_bench), "Demarrage...");
+  char buf[64];
+  if (job->gaps)
+    snprintf(buf, sizeof(buf), "Comparaison des ecarts en cours...");
+  else
+    snprintf(buf, sizeof(buf), "Benchmark en cours (graine %u)...", job->seed);
+  gtk_label_set_text(GTK_LABEL(label_stats), buf);
 
-  for (int s = 0; s < perf_samples; s++) {
-    int n = (s + 1) * step;
-    int *temp = malloc(n * sizeof(int));
-    for (int a = 0; a < 4; a++) {
-      for (int k = 0; k < n; k++)
-        temp[k] = rand() % 1000;
-
-      gint64 start = g_get_monotonic_time();
-      if (a == 0)
-        bubble_bench(temp, n);
-      else if (a == 1)
-        insertion_bench(temp, n);
-      else if (a == 2)
-        shell_bench(temp, n);
-      else
-        quick_bench(temp, 0, n - 1);
-      gint64 end = g_get_monotonic_time();
+  g_thread_unref(g_thread_new("sort-bench",
+                              job->gaps ? gaps_worker : bench_worker, job));
+}
 
-      perf_times[a][s] = (double)(end - start) / 1000.0; // ms
+// sizes: count increasing sizes (count <= PERF_MAX_SAMPLES). A geometric
+// sweep is drawn on log-log axes.
+static void run_benchmark_graph(const int *sizes, int count,
+                                gboolean geometric) {
+  if (!perf_times[0]) {
+    for (int a = 0; a < sort_kernel_count; a++) {
+      perf_times[a] = malloc(PERF_MAX_SAMPLES * sizeof(double));
+      perf_min[a] = malloc(PERF_MAX_SAMPLES * sizeof(double));
+      perf_p95[a] = malloc(PERF_MAX_SAMPLES * sizeof(double));
+      perf_ops[a] = malloc(PERF_MAX_SAMPLES * sizeof(SortOps));
+      perf_boxed[a] = malloc(PERF_MAX_SAMPLES * sizeof(double));
+      perf_stats[a] = malloc(PERF_MAX_SAMPLES * sizeof(BenchStats));
+      perf_hw[a] = malloc(PERF_MAX_SAMPLES * sizeof(PerfSample));
     }
-    free(temp);
   }
+  for (int a = 0; a < sort_kernel_count; a++)
+    perf_done[a] = 0;
+  memcpy(perf_n, sizes, count * sizeof(int));
+  perf_samples = count;
+  perf_log_axes = geometric;
+
+  BenchJob *job = g_new0(BenchJob, 1);
+  job->max_n = sizes[count - 1];
+  job->samples = count;
+  memcpy(job->sizes, sizes, count * sizeof(int));
+  job->skip_ms = geometric ? PERF_SKIP_MS : 0.0;
+  job->threads[0] = parallel_get_threads();
+  job->seed = dataset_seed();
+  job->with_boxed = perf_show_boxed =
+      gtk_check_button_get_active(GTK_CHECK_BUTTON(check_boxed_graph));
+  job->with_counters =
+      gtk_check_button_get_active(GTK_CHECK_BUTTON(check_counters));
+  // Counting only when the graph shows operations: the extra runs cost as
+  // much as a timed run
+  job->with_ops = perf_have_ops =
+      gtk_combo_box_get_active(GTK_COMBO_BOX(combo_metric)) > 0;
 
-  g_string_append_printf(
-      stats_str, "Bulle: %.3f\nInsertion: %.3f\nShell: %.3f\nRapide: %.3f",
-      perf_times[0][perf_samples - 1], perf_times[1][perf_samples - 1],
-      perf_times[2][perf_samples - 1], perf_times[3][perf_samples - 1]);
+  graph_ready = TRUE;
+  graph_scaling = FALSE;
+  start_bench_job(job);
+}
 
-  gtk_label_set_text(GTK_LABEL(label_stats), stats_str->str);
-  g_string_free(stats_str, TRUE);
+// Scaling curve: thread counts 1, 2, 4, ... up to the "Threads" value
+static void run_scaling_graph(int n) {
+  int max_threads = parallel_get_threads();
+  scale_count = 0;
+  for (int t = 1; t < max_threads; t *= 2)
+    scale_threads[scale_count++] = t;
+  scale_threads[scale_count++] = max_threads;
+  scale_done = 0;
+  scale_n = n;
+
+  BenchJob *job = g_new0(BenchJob, 1);
+  job->max_n = n;
+  job->samples = scale_count;
+  job->seed = dataset_seed();
+  job->scaling = TRUE;
+  memcpy(job->threads, scale_threads, sizeof(scale_threads));
 
   graph_ready = TRUE;
+  graph_scaling = TRUE;
+  start_bench_job(job);
+}
+
+static void cancel_benchmark(void) {
+  if (!bench_job || g_atomic_int_get(&bench_job->cancelled))
+    return;
+  // The worker notices the flag after its current kernel call, which can
+  // take a while at large sizes; a new job only starts after its last update
+  g_atomic_int_set(&bench_job->cancelled, 1);
+  gtk_widget_set_sensitive(btn_cancel, FALSE);
+  gtk_progress_bar_set_text(GTK_PROGRESS_BAR(progress_bench),
+                            "Annulation...");
+  gtk_label_set_text(GTK_LABEL(label_stats),
+                     "Benchmark annule (fin de la mesure en cours).");
+}
+
+// --- File Choosers ---
+
+typedef void (*FileChosenFunc)(const char *path);
+
+static void on_file_response(GtkNativeDialog *dlg, int response,
+                             gpointer data) {
+  if (response == GTK_RESPONSE_ACCEPT) {
+    GFile *file = gtk_file_chooser_get_file(GTK_FILE_CHOOSER(dlg));
+    char *path = g_file_get_path(file);
+    ((FileChosenFunc)data)(path);
+    g_free(path);
+    g_object_unref(file);
+  }
+  g_object_unref(dlg);
+}
+
+static void choose_file(GtkButton *btn, const char *title,
+                        GtkFileChooserAction action, const char *accept,
+                        FileChosenFunc done) {
+  GtkFileChooserNative *dlg = gtk_file_chooser_native_new(
+      title, GTK_WINDOW(gtk_widget_get_root(GTK_WIDGET(btn))), action, accept,
+      "Annuler");
+  g_signal_connect(dlg, "response", G_CALLBACK(on_file_response), done);
+  gtk_native_dialog_show(GTK_NATIVE_DIALOG(dlg));
+}
+
+// --- External Sort ---
+// Binary file of native ints/doubles sorted to "<file>.trie" on a GThread;
+// the result comes back through g_idle_add like the benchmark updates.
+
+typedef struct {
+  char *in_path;
+  char *out_path;
+  DataType type;
+  int algo;
+  int desc;
+  size_t mem_bytes;
+  int rc;
+  int err; // errno when rc != 0
+  ExtSortStats st;
+} ExtSortJob;
+
+static gboolean ext_sort_done(gpointer data) {
+  ExtSortJob *job = data;
+  char buf[512];
+  if (job->rc != 0)
+    snprintf(buf, sizeof(buf), "Tri externe: echec (%s)\n%s",
+             g_strerror(job->err), job->in_path);
+  else
+    snprintf(buf, sizeof(buf),
+             "Tri externe (%s): %lld elements -> %s\n"
+             "%d runs, %d passe(s) de fusion\n"
+             "Lecture: %.1f ms\nTri des blocs: %.1f ms\n"
+             "Ecriture des runs: %.1f ms\nFusion: %.1f ms\nTotal: %.1f ms",
+             sort_kernels[job->algo].name, job->st.count, job->out_path,
+             job->st.runs, job->st.passes, job->st.read_ms, job->st.sort_ms,
+             job->st.write_ms, job->st.merge_ms, job->st.total_ms);
+  gtk_label_set_text(GTK_LABEL(label_stats), buf);
+  gtk_widget_set_sensitive(btn_ext_sort, TRUE);
+
+  g_free(job->in_path);
+  g_free(job->out_path);
+  g_free(job);
+  return G_SOURCE_REMOVE;
+}
+
+static gpointer ext_sort_worker(gpointer data) {
+  ExtSortJob *job = data;
+  job->rc = external_sort_file(job->in_path, job->out_path, job->type,
+                               job->algo, job->desc, job->mem_bytes, NULL,
+                               &job->st);
+  job->err = errno;
+  g_idle_add(ext_sort_done, job);
+  return NULL;
+}
+
+static void start_ext_sort(const char *path) {
+  ExtSortJob *job = g_new0(ExtSortJob, 1);
+  job->in_path = g_strdup(path);
+  job->out_path = g_strconcat(path, ".trie", NULL);
+  int type = gtk_combo_box_get_active(GTK_COMBO_BOX(combo_type));
+  int mem_mb = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spin_ext_mem));
+  job->type = type == TYPE_DOUBLE ? TYPE_DOUBLE : TYPE_INT;
+  job->algo = gtk_combo_box_get_active(GTK_COMBO_BOX(combo_algo));
+  job->desc = gtk_check_button_get_active(GTK_CHECK_BUTTON(radio_desc));
+  job->mem_bytes = (size_t)mem_mb << 20;
+
+  gtk_widget_set_sensitive(btn_ext_sort, FALSE);
+  gtk_label_set_text(GTK_LABEL(label_stats), "Tri externe en cours...");
+  g_thread_unref(g_thread_new("ext-sort", ext_sort_worker, job));
+}
+
+// --- File Load / Save ---
+// Numeric files go through typed_io.c (mmap) straight into data_typed; only
+// the first values reach the text view.
+
+static void load_file(const char *path) {
+  int idx = gtk_combo_box_get_active(GTK_COMBO_BOX(combo_type));
+  DataType type = idx == TYPE_DOUBLE ? TYPE_DOUBLE : TYPE_INT;
+  FileFormat fmt = typed_file_sniff(path);
+
+  gint64 start = g_get_monotonic_time();
+  int rc = typed_file_load(&data_typed, path, type, fmt);
+  double ms = (g_get_monotonic_time() - start) / 1000.0;
+
+  char buf[256];
+  if (rc != 0) {
+    snprintf(buf, sizeof(buf), "Chargement impossible: %s", g_strerror(errno));
+  } else {
+    current_dtype = type;
+    gtk_combo_box_set_active(GTK_COMBO_BOX(combo_type), type);
+    show_new_data();
+    snprintf(buf, sizeof(buf), "Charge (%s): %d valeurs en %.1f ms",
+             fmt == FILE_BINARY ? "binaire" : "texte", data_typed.n, ms);
+  }
+  gtk_label_set_text(GTK_LABEL(label_stats), buf);
+}
+
+static void save_file(const char *path) {
+  FileFormat fmt = typed_file_format_for(path);
+  gint64 start = g_get_monotonic_time();
+  int rc = typed_file_save(&data_typed, path, fmt);
+  double ms = (g_get_monotonic_time() - start) / 1000.0;
+
+  char buf[256];
+  if (rc != 0)
+    snprintf(buf, sizeof(buf), "Enregistrement impossible: %s",
+             g_strerror(errno));
+  else
+    snprintf(buf, sizeof(buf), "Enregistre (%s): %d valeurs en %.1f ms",
+             fmt == FILE_BINARY ? "binaire" : "texte", data_typed.n, ms);
+  gtk_label_set_text(GTK_LABEL(label_stats), buf);
+}
+
+// Every measured point of the last sweep, with the machine description
+static void save_results(const char *path) {
+  int count = 0;
+  for (int a = 0; a < sort_kernel_count; a++)
+    count += perf_done[a];
+  if (count == 0) {
+    gtk_label_set_text(GTK_LABEL(label_stats),
+                       "Export: aucun resultat, lancez 'Comparer'");
+    return;
+  }
+
+  BenchRecord *recs = g_new0(BenchRecord, count);
+  BenchRecord *r = recs;
+  for (int a = 0; a < sort_kernel_count; a++)
+    for (int s = 0; s < perf_done[a]; s++, r++) {
+      g_strlcpy(r->algo, sort_kernels[a].id, sizeof(r->algo));
+      g_strlcpy(r->storage, "typed", sizeof(r->storage));
+      r->threads = a == ALGO_PARALLEL ? perf_params.threads[0] : 1;
+      r->n = perf_n[s];
+      g_strlcpy(r->dist, bench_dist_id(perf_params.dist), sizeof(r->dist));
+      r->disorder =
+          perf_params.dist == DIST_NEARLY_SORTED ? perf_params.disorder : -1;
+      r->seed = perf_params.seed + s; // Seed of the sample's input
+      r->warmup = perf_params.warmup;
+      r->st = perf_stats[a][s];
+      r->boxed_ms = perf_show_boxed ? perf_boxed[a][s] : -1;
+      r->hw = perf_hw[a][s];
+    }
+  BenchMachine machine;
+  bench_machine_info(&machine);
+  ResultsFormat fmt = bench_results_format_for(path);
+  int rc = bench_results_save(path, fmt, &machine, recs, count);
+  g_free(recs);
+
+  char buf[256];
+  if (rc != 0)
+    snprintf(buf, sizeof(buf), "Export impossible: %s", g_strerror(errno));
+  else
+    snprintf(buf, sizeof(buf), "Export (%s): %d mesures\n%s",
+             fmt == RESULTS_JSON ? "JSON" : "CSV", count, path);
+  gtk_label_set_text(GTK_LABEL(label_stats), buf);
+}
+
+static void load_baseline(const char *path) {
+  BenchRecord *recs;
+  int count = bench_results_load(path, &recs);
+  char buf[256];
+  if (count < 0) {
+    snprintf(buf, sizeof(buf), "Reference illisible: %s", g_strerror(errno));
+    gtk_label_set_text(GTK_LABEL(label_stats), buf);
+    return;
+  }
+  free(baseline);
+  g_free(baseline_name);
+  baseline = recs;
+  baseline_count = count;
+  baseline_name = g_path_get_basename(path);
+
+  GString *str = g_string_new(NULL);
+  g_string_printf(str, "Reference %s: %d mesures", baseline_name, count);
+  if (graph_ready && !graph_scaling)
+    append_regressions(str);
+  gtk_label_set_text(GTK_LABEL(label_stats), str->str);
+  g_string_free(str, TRUE);
+  gtk_widget_queue_draw(drawing_area);
 }
 
 // --- Callbacks ---
@@ -306,66 +1065,235 @@ static void on_gen(GtkButton *btn, gpointer data) {
   else
     current_dtype = TYPE_STRING;
 
-  generate_text_data(n);
-  update_text_view(text_before, data_array, n);
-
-  GtkTextBuffer *buf = gtk_text_view_get_buffer(GTK_TEXT_VIEW(text_after));
-  gtk_text_buffer_set_text(buf, "", -1);
+  double ms[3];
+  unsigned int seed = dataset_seed();
+  generate_text_data(n, gtk_combo_box_get_active(GTK_COMBO_BOX(combo_dist)),
+                     seed, ms);
+  show_new_data();
+
+  char buf[256];
+  snprintf(buf, sizeof(buf),
+           "Genere: %d valeurs (graine %u)\nLiberation: %.3f ms, allocation: "
+           "%.3f ms, remplissage: %.3f ms",
+           n, seed, ms[0], ms[1], ms[2]);
+  gtk_label_set_text(GTK_LABEL(label_stats), buf);
 }
 
 static void on_sort_text_only(GtkButton *btn, gpointer data) {
-  if (!data_array)
+  if (data_typed.n == 0)
     return;
 
-  int algo_idx = gtk_combo_box_get_active(GTK_COMBO_BOX(combo_algo));
-  // 0=Bulle, 1=Insertion, 2=Shell, 3=Rapide
+  // The "before" view keeps the unsorted values: snapshot them once
+  if (data_before.n == 0) {
+    typed_array_copy(&data_before, &data_typed);
+    typed_view_set(text_before, &data_before);
+  }
 
-  gint64 start = g_get_monotonic_time();
+  int algo_idx = gtk_combo_box_get_active(GTK_COMBO_BOX(combo_algo));
+  // Same order as SortAlgo (sort.h)
+  int storage = gtk_combo_box_get_active(GTK_COMBO_BOX(combo_storage));
+  gboolean boxed = storage != STORAGE_TYPED;
+  Arena *arena = storage == STORAGE_BOXED_ARENA ? &box_arena : NULL;
+  gint64 start, end;
+
+  double ref_ms = -1.0;
+  const char *ref_name = "Avant (cmp_generic)";
+  double box_ms = 0.0, unbox_ms = 0.0;
+
+  if (boxed) {
+    // Baseline: one allocation per element (or bumped from box_arena), void*
+    // sorts. Boxing/unboxing is timed apart from the sort.
+    int n = data_typed.n;
+
+    // Before: same input through cmp_generic, for the log only (there is no
+    // cmp_generic version of Introsort)
+    if (algo_idx <= ALGO_QUICK) {
+      void **ref = typed_box(&data_typed, arena);
+#ifdef SORT_COUNT_OPS
+      memset(&sort_ops_generic, 0, sizeof(sort_ops_generic));
+#endif
+      start = g_get_monotonic_time();
+      if (algo_idx == ALGO_BUBBLE)
+        bubble_sort_generic(ref, n);
+      else if (algo_idx == ALGO_INSERTION)
+        insertion_sort_generic(ref, n);
+      else if (algo_idx == ALGO_SHELL)
+        shell_sort_generic(ref, n);
+      else
+        quick_sort_generic(ref, 0, n - 1);
+      ref_ms = (g_get_monotonic_time() - start) / 1000.0;
+      if (arena) {
+        arena_reset(arena);
+      } else {
+        for (int i = 0; i < n; i++)
+          free(ref[i]);
+        free(ref);
+      }
+    }
 
-  // Call the specific GENERIC sort
-  if (algo_idx == 0)
-    bubble_sort_generic(data_array, data_size);
-  else if (algo_idx == 1)
-    insertion_sort_generic(data_array, data_size);
-  else if (algo_idx == 2)
-    shell_sort_generic(data_array, data_size);
-  else
-    quick_sort_generic(data_array, 0, data_size - 1);
+    gint64 t0 = g_get_monotonic_time();
+    void **arr = typed_box(&data_typed, arena);
+    start = g_get_monotonic_time();
+    sort_generic(arr, n, algo_idx);
+    end = g_get_monotonic_time();
+    typed_unbox(&data_typed, arr, arena);
+    box_ms = (start - t0) / 1000.0;
+    unbox_ms = (g_get_monotonic_time() - end) / 1000.0;
+  } else {
+    gboolean desc = gtk_check_button_get_active(GTK_CHECK_BUTTON(radio_desc));
+
+    // Strings on "Radix" run the multikey quicksort: same input through a
+    // strcmp sort on boxes for comparison (Introsort, so sorted or equal
+    // keys do not blow the stack like the Lomuto quicksort would)
+    if (current_dtype == TYPE_STRING && algo_idx == ALGO_RADIX) {
+      void **ref = typed_box(&data_typed, &box_arena);
+      start = g_get_monotonic_time();
+      boxed_sort(ref, data_typed.n, TYPE_STRING, ALGO_INTRO, desc);
+      ref_ms = (g_get_monotonic_time() - start) / 1000.0;
+      ref_name = "Introsort void** (strcmp)";
+      arena_reset(&box_arena);
+    }
 
-  gint64 end = g_get_monotonic_time();
+    start = g_get_monotonic_time();
+    typed_sort(&data_typed, algo_idx, desc);
+    end = g_get_monotonic_time();
+  }
 
-  update_text_view(text_after, data_array, data_size);
+  typed_view_set(text_after, &data_typed);
 
   // Log
-  char buf[128];
-  sprintf(buf, "Tri Texte (%s): %.3f ms",
-          (algo_idx == 0
-               ? "Bulle"
-               : (algo_idx == 1 ? "Insertion"
-                                : (algo_idx == 2 ? "Shell" : "Rapide"))),
-          (end - start) / 1000.0);
+  char buf[256];
+  double ms = (end - start) / 1000.0;
+  int len = sprintf(buf, "Tri Texte (%s, %s): %.3f ms",
+                    sort_kernels[algo_idx].name,
+                    !boxed  ? "contigu"
+                    : arena ? "void**, arene"
+                            : "void**",
+                    ms);
+  if (boxed)
+    len += sprintf(buf + len, "\nAllocation: %.3f ms, liberation: %.3f ms",
+                   box_ms, unbox_ms);
+  if (ref_ms >= 0)
+    len += sprintf(buf + len, "\n%s: %.3f ms (x%.1f)", ref_name, ref_ms,
+                   ms > 0 ? ref_ms / ms : 0.0);
+#ifdef SORT_COUNT_OPS
+  if (ref_ms >= 0 && boxed)
+    len += sprintf(buf + len, "\n%lld comparaisons, %lld echanges, %lld depl.",
+                   sort_ops_generic.cmp, sort_ops_generic.swaps,
+                   sort_ops_generic.moves);
+#endif
+  if (boxed ? !sort_is_comparison(algo_idx)
+            : !typed_sort_supports(current_dtype, algo_idx))
+    sprintf(buf + len, "\n%s indisponible ici, Introsort utilise",
+            sort_kernels[algo_idx].name);
+  else if (algo_idx == ALGO_SIMD && !simd_sort_available())
+    sprintf(buf + len, "\nAVX2 absent: version scalaire");
+  gtk_label_set_text(GTK_LABEL(label_stats), buf);
+}
+
+// --- Selection ---
+// Only the k first values of the sort order, timed against sorting a copy of
+// everything (Introsort) and keeping its prefix.
+
+static const char *select_names[SELECT_COUNT] = {
+    "k-ieme element (introselect)", "Top-k (tas)", "Tri partiel (quicksort)"};
+
+// Same value at index i in both arrays (same type)
+static gboolean same_value(const TypedArray *a, const TypedArray *b, int i) {
+  switch (a->type) {
+  case TYPE_INT:
+    return a->ints[i] == b->ints[i];
+  case TYPE_DOUBLE:
+    return a->doubles[i] == b->doubles[i];
+  case TYPE_CHAR:
+    return a->chars[i] == b->chars[i];
+  default:
+    return strcmp(a->strs[i], b->strs[i]) == 0;
+  }
+}
+
+static void on_select(GtkButton *btn, gpointer data) {
+  int n = data_typed.n;
+  if (n == 0)
+    return;
+
+  if (data_before.n == 0) {
+    typed_array_copy(&data_before, &data_typed);
+    typed_view_set(text_before, &data_before);
+  }
+
+  int mode = gtk_combo_box_get_active(GTK_COMBO_BOX(combo_select));
+  int k = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spin_k));
+  if (k <= 0)
+    k = (n + 1) / 2; // Median
+  if (k > n)
+    k = n;
+  gboolean desc = gtk_check_button_get_active(GTK_CHECK_BUTTON(radio_desc));
+
+  // Reference: full sort, then only the prefix is used
+  TypedArray full;
+  typed_array_copy(&full, &data_typed);
+  gint64 start = g_get_monotonic_time();
+  typed_sort(&full, ALGO_INTRO, desc);
+  double full_ms = (g_get_monotonic_time() - start) / 1000.0;
+
+  start = g_get_monotonic_time();
+  typed_select(&data_typed, mode, k, desc);
+  double ms = (g_get_monotonic_time() - start) / 1000.0;
+
+  gboolean ok = TRUE;
+  for (int i = mode == SELECT_NTH ? k - 1 : 0; i < k && ok; i++)
+    ok = same_value(&data_typed, &full, i);
+  typed_array_free(&full);
+
+  typed_view_set(text_after, &data_typed);
+
+  char buf[256];
+  snprintf(buf, sizeof(buf),
+           "Selection %s, k=%d: %.3f ms\nTri complet (Introsort) + prefixe: "
+           "%.3f ms (x%.1f)\nVerification: %s",
+           select_names[mode], k, ms, full_ms, ms > 0 ? full_ms / ms : 0.0,
+           ok ? "OK" : "ERREUR");
   gtk_label_set_text(GTK_LABEL(label_stats), buf);
 }
 
 static void on_compare(GtkButton *btn, gpointer data) {
-  const char *sz_txt = gtk_editable_get_text(GTK_EDITABLE(entry_size));
-  int max_n = atoi(sz_txt);
-  if (max_n <= 0)
-    max_n = 500;
-  if (max_n > 5000)
-    max_n = 5000; // Cap for sanity
+  int sizes[PERF_MAX_SAMPLES], count;
+  gboolean geometric =
+      gtk_combo_box_get_active(GTK_COMBO_BOX(combo_sweep)) == 1;
+  if (geometric) {
+    int lo = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spin_sweep_lo));
+    int hi = gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spin_sweep_hi));
+    if (hi <= lo)
+      hi = lo + 1;
+    count = bench_geometric_sizes(
+        lo, hi,
+        gtk_spin_button_get_value_as_int(GTK_SPIN_BUTTON(spin_sweep_steps)),
+        sizes, PERF_MAX_SAMPLES);
+  } else {
+    const char *sz_txt = gtk_editable_get_text(GTK_EDITABLE(entry_size));
+    int max_n = atoi(sz_txt);
+    if (max_n <= 0)
+      max_n = 500;
+    if (max_n > 100000)
+      max_n = 100000; // Runs in the background now, cancel stays available
+    count = 4;
+    int step = max_n / count > 0 ? max_n / count : 1;
+    for (int s = 0; s < count; s++)
+      sizes[s] = (s + 1) * step;
+  }
 
-  // Run benchmark (updates graph)
-  run_benchmark_graph(max_n);
+  // Run benchmark (the worker updates the graph as results come in)
+  run_benchmark_graph(sizes, count, geometric);
 
   // ALSO update the "After Sort" text view with a sorted version of the CURRENT
   // data so the user sees something happened in the text box too.
-  if (data_array && data_size > 0) {
+  if (data_typed.n > 0) {
     // Create a shallow copy for sorting (don't free the actual
     // strings/pointers, just the array) Note: We need a DEEP copy if we were to
     // modify content, but sorting just swaps pointers. However, we can't mess
-    // up the original 'data_array' if the user wants to run other sorts?
-    // Actually, 'Sort' button modifies 'data_array'. Compare usually runs on
+    // up the original data if the user wants to run other sorts?
+    // Actually, 'Sort' button modifies the data. Compare usually runs on
     // random data generated internally? Wait, 'run_benchmark_graph' generates
     // its OWN random data. The user expectation is likely: "Compare runs on the
     // data I generated or new data?" Usually Compare generates its own range of
@@ -375,29 +1303,119 @@ static void on_compare(GtkButton *btn, gpointer data) {
     // qu'on j'ai clique sur trier au moment il fonctionne" implying they want
     // to see *some* result.
 
-    // Let's sort the CURRENT visible data using Quick Sort as a "Demo" of the
-    // result.
-    void **copy = malloc(data_size * sizeof(void *));
-    memcpy(copy, data_array, data_size * sizeof(void *));
+    // Let's sort the CURRENT visible data using Introsort as a "Demo" of the
+    // result, on a copy so data_typed keeps its original order.
+    // Kept in data_demo: the view reads it while scrolling
+    typed_array_free(&data_demo);
+    typed_array_copy(&data_demo, &data_typed);
+
+    typed_sort(&data_demo, ALGO_INTRO,
+               gtk_check_button_get_active(GTK_CHECK_BUTTON(radio_desc)));
+    typed_view_set(text_after, &data_demo);
+  }
+
+  gtk_widget_queue_draw(drawing_area);
+}
+
+static void on_scaling(GtkButton *btn, gpointer data) {
+  const char *sz_txt = gtk_editable_get_text(GTK_EDITABLE(entry_size));
+  int n = atoi(sz_txt);
+  if (n <= 0)
+    n = 1000000;
+  if (n > 50000000)
+    n = 50000000; // Two int buffers of this size are allocated
+
+  run_scaling_graph(n);
+  gtk_widget_queue_draw(drawing_area);
+}
+
+static void on_threads_changed(GtkSpinButton *spin, gpointer data) {
+  parallel_set_threads(gtk_spin_button_get_value_as_int(spin));
+}
+
+static void on_gaps_changed(GtkComboBox *combo, gpointer data) {
+  shell_set_gaps(gtk_combo_box_get_active(combo));
+}
+
+// Shell sort of the current data with every gap sequence, same input each
+// time; integers also get their comparison and move counts. Runs as a
+// benchmark job on a snapshot of the data, so it can be cancelled and the
+// view stays usable on large files.
+static void on_compare_gaps(GtkButton *btn, gpointer data) {
+  if (data_typed.n == 0 || bench_job)
+    return;
+  BenchJob *job = g_new0(BenchJob, 1);
+  job->gaps = TRUE;
+  typed_array_copy(&job->data, &data_typed);
+  job->descending = gtk_check_button_get_active(GTK_CHECK_BUTTON(radio_desc));
+  gaps_done = 0;
+  start_bench_job(job);
+}
+
+static void on_cancel(GtkButton *btn, gpointer data) { cancel_benchmark(); }
+
+static void on_ext_sort(GtkButton *btn, gpointer data) {
+  int type = gtk_combo_box_get_active(GTK_COMBO_BOX(combo_type));
+  if (type != TYPE_INT && type != TYPE_DOUBLE) {
+    gtk_label_set_text(GTK_LABEL(label_stats),
+                       "Tri externe: type Entier ou Reel uniquement");
+    return;
+  }
+  choose_file(btn, "Fichier binaire a trier", GTK_FILE_CHOOSER_ACTION_OPEN,
+              "Trier", start_ext_sort);
+}
 
-    quick_sort_generic(copy, 0, data_size - 1);
-    update_text_view(text_after, copy, data_size);
+static void on_load_file(GtkButton *btn, gpointer data) {
+  choose_file(btn, "Charger des nombres (binaire ou une valeur par ligne)",
+              GTK_FILE_CHOOSER_ACTION_OPEN, "Charger", load_file);
+}
 
-    free(copy);
-    // We don't free the elements because they are shared with data_array!
+static void on_save_file(GtkButton *btn, gpointer data) {
+  if (data_typed.n == 0 ||
+      (data_typed.type != TYPE_INT && data_typed.type != TYPE_DOUBLE)) {
+    gtk_label_set_text(GTK_LABEL(label_stats),
+                       "Enregistrement: donnees Entier ou Reel uniquement");
+    return;
   }
+  choose_file(btn, "Enregistrer (.txt/.csv: texte, sinon binaire)",
+              GTK_FILE_CHOOSER_ACTION_SAVE, "Enregistrer", save_file);
+}
 
+static void on_metric_changed(GtkComboBox *combo, gpointer data) {
+  gtk_widget_queue_draw(drawing_area);
+}
+
+static void on_export(GtkButton *btn, gpointer data) {
+  choose_file(btn, "Exporter les resultats (.json: JSON, sinon CSV)",
+              GTK_FILE_CHOOSER_ACTION_SAVE, "Exporter", save_results);
+}
+
+static void on_baseline(GtkButton *btn, gpointer data) {
+  choose_file(btn, "Charger une reference (export CSV/JSON, sort_bench -S)",
+              GTK_FILE_CHOOSER_ACTION_OPEN, "Charger", load_baseline);
+}
+
+static void on_baseline_clear(GtkButton *btn, gpointer data) {
+  free(baseline);
+  g_free(baseline_name);
+  baseline = NULL;
+  baseline_name = NULL;
+  baseline_count = 0;
+  gtk_widget_queue_draw(drawing_area);
+}
+
+static void on_regress_changed(GtkSpinButton *spin, gpointer data) {
   gtk_widget_queue_draw(drawing_area);
 }
 
 static void on_reset(GtkButton *btn, gpointer data) {
+  cancel_benchmark();
   free_data();
   graph_ready = FALSE;
-  GtkTextBuffer *b1 = gtk_text_view_get_buffer(GTK_TEXT_VIEW(text_before));
-  gtk_text_buffer_set_text(b1, "", -1);
-  GtkTextBuffer *b2 = gtk_text_view_get_buffer(GTK_TEXT_VIEW(text_after));
-  gtk_text_buffer_set_text(b2, "", -1);
+  graph_scaling = FALSE;
   gtk_label_set_text(GTK_LABEL(label_stats), "");
+  gtk_progress_bar_set_fraction(GTK_PROGRESS_BAR(progress_bench), 0.0);
+  gtk_progress_bar_set_text(GTK_PROGRESS_BAR(progress_bench), "");
   gtk_widget_queue_draw(drawing_area);
 }
 
@@ -406,59 +1424,334 @@ static void on_back(GtkButton *btn, AppContext *ctx) {
 }
 
 // --- Drawing ---
+
+// Speedup of the parallel sort (time with 1 thread / time with t threads)
+// against the thread count, with the ideal linear speedup dashed.
+// One colour per algorithm, shared by every graph
+static const double curve_col[SORT_KERNEL_MAX][3] = {
+    {0, 0, 1},       {1, 0.5, 0},     {0, 0.8, 0},   {1, 0, 0},
+    {0.6, 0, 0.8},   {0, 0.7, 0.7},   {0.5, 0.3, 0}, {1, 0, 0.6},
+    {0.4, 0.4, 0.4}, {0.6, 0.6, 0},   {0, 0.3, 0.6}, {0.9, 0.4, 0.4},
+    {0.3, 0.6, 0.3}, {0.7, 0.5, 0.9}, {0.2, 0.2, 0}, {1, 0.8, 0}};
+
+// X of size n on the sweep graphs: log scale for a geometric sweep
+static double size_x(double n, int m, int gw) {
+  double lo = perf_n[0], hi = perf_n[perf_samples - 1];
+  if (hi <= lo)
+    return m + gw / 2.0;
+  if (perf_log_axes)
+    return m + log(n / lo) / log(hi / lo) * gw;
+  return m + (n - lo) / (hi - lo) * gw;
+}
+
+// Size in the sweep, between the first and last one (t in [0, 1])
+static double size_at(double t) {
+  double lo = perf_n[0], hi = perf_n[perf_samples - 1];
+  return perf_log_axes ? lo * pow(hi / lo, t) : lo + (hi - lo) * t;
+}
+
+static void format_size(char *buf, int n) {
+  if (n < 100000)
+    sprintf(buf, "%d", n);
+  else if (n < 1000000)
+    sprintf(buf, "%.0fk", n / 1e3);
+  else
+    sprintf(buf, "%.1fM", n / 1e6);
+}
+
+// Size labels (and vertical grid lines) under the sweep graphs, skipping
+// the ones that would overlap on a long geometric sweep
+static void draw_size_axis(cairo_t *cr, int h, int m, int gw, gboolean grid) {
+  double last_x = -1e9;
+  cairo_set_line_width(cr, 1);
+  for (int s = 0; s < perf_samples; s++) {
+    double x = size_x(perf_n[s], m, gw);
+    if (x - last_x < 55)
+      continue;
+    last_x = x;
+    if (grid) {
+      cairo_set_source_rgb(cr, 0.9, 0.9, 0.9);
+      cairo_move_to(cr, x, m);
+      cairo_line_to(cr, x, h - m);
+      cairo_stroke(cr);
+    }
+    char buf[32];
+    format_size(buf, perf_n[s]);
+    cairo_set_source_rgb(cr, 0.4, 0.4, 0.4);
+    cairo_move_to(cr, x - 10, h - m + 20);
+    cairo_show_text(cr, buf);
+  }
+}
+
+static double ops_value(const SortOps *o, int metric) {
+  return metric == 1 ? o->cmp : metric == 2 ? o->swaps : o->moves;
+}
+
+// Operation counts vs N on a log10 Y axis, with n*log2(n) and n^2/2 dashed
+static void draw_ops(cairo_t *cr, int w, int h, int metric) {
+  static const char *metric_names[] = {NULL, "Comparaisons", "Echanges",
+                                       "Deplacements"};
+  int m = 60; // Margin
+  int gw = w - 2 * m;
+  int gh = h - 2 * m;
+  double max_n = perf_n[perf_samples - 1];
+
+  double max_v = max_n * max_n / 2;
+  for (int a = 0; a < sort_kernel_count; a++)
+    for (int s = 0; s < perf_done[a]; s++)
+      if (ops_value(&perf_ops[a][s], metric) > max_v)
+        max_v = ops_value(&perf_ops[a][s], metric);
+  int decades = (int)ceil(log10(max_v));
+  if (decades < 1)
+    decades = 1;
+
+  // Axes and decade grid
+  cairo_set_font_size(cr, 12);
+  for (int d = 0; d <= decades; d++) {
+    double y = (h - m) - (double)d / decades * gh;
+    cairo_set_source_rgb(cr, 0.9, 0.9, 0.9);
+    cairo_set_line_width(cr, 1);
+    cairo_move_to(cr, m, y);
+    cairo_line_to(cr, w - m, y);
+    cairo_stroke(cr);
+    char buf[32];
+    sprintf(buf, "1e%d", d);
+    cairo_set_source_rgb(cr, 0.4, 0.4, 0.4);
+    cairo_move_to(cr, 10, y + 4);
+    cairo_show_text(cr, buf);
+  }
+  draw_size_axis(cr, h, m, gw, FALSE);
+  cairo_set_source_rgb(cr, 0.1, 0.1, 0.1);
+  cairo_set_line_width(cr, 2);
+  cairo_move_to(cr, m, h - m);
+  cairo_line_to(cr, w - m, h - m);
+  cairo_move_to(cr, m, h - m);
+  cairo_line_to(cr, m, m);
+  cairo_stroke(cr);
+
+  cairo_set_source_rgb(cr, 0, 0, 0);
+  cairo_move_to(cr, w / 2 - 40, h - 20);
+  cairo_show_text(cr, "Taille de tableau");
+  cairo_set_font_size(cr, 16);
+  char title[96];
+  sprintf(title, "%s vs Taille (echelle log)", metric_names[metric]);
+  cairo_move_to(cr, w / 2 - 140, 30);
+  cairo_show_text(cr, title);
+  cairo_set_font_size(cr, 12);
+
+// Screen position of (n, v); values below 1 sit on the X axis
+#define OPS_X(n) size_x(n, m, gw)
+#define OPS_Y(v) ((h - m) - ((v) > 1 ? log10(v) : 0) / decades * gh)
+
+  // Reference curves, sampled finely between the first and last N
+  double dash[] = {8.0, 6.0};
+  cairo_set_dash(cr, dash, 2, 0);
+  cairo_set_line_width(cr, 2);
+  for (int ref = 0; ref < 2; ref++) {
+    cairo_set_source_rgb(cr, 0.6, 0.6, 0.6);
+    cairo_new_path(cr);
+    for (int k = 0; k <= 50; k++) {
+      double n = size_at(k / 50.0);
+      double v = ref == 0 ? n * log2(n) : n * n / 2;
+      if (k == 0)
+        cairo_move_to(cr, OPS_X(n), OPS_Y(v));
+      else
+        cairo_line_to(cr, OPS_X(n), OPS_Y(v));
+    }
+    cairo_stroke(cr);
+    cairo_move_to(cr, w - m + 5,
+                  OPS_Y(ref == 0 ? max_n * log2(max_n) : max_n * max_n / 2));
+    cairo_show_text(cr, ref == 0 ? "n log n" : "n^2/2");
+  }
+  cairo_set_dash(cr, NULL, 0, 0);
+
+  for (int a = 0; a < sort_kernel_count; a++) {
+    if (!sort_ops_supported(a))
+      continue;
+    cairo_set_source_rgb(cr, curve_col[a][0], curve_col[a][1],
+                         curve_col[a][2]);
+    cairo_rectangle(cr, w - 120, 50 + a * 25, 15, 15);
+    cairo_fill(cr);
+    cairo_move_to(cr, w - 90, 62 + a * 25);
+    cairo_show_text(cr, sort_kernels[a].name);
+
+    cairo_set_line_width(cr, 4);
+    cairo_new_path(cr);
+    for (int s = 0; s < perf_done[a]; s++) {
+      double v = ops_value(&perf_ops[a][s], metric);
+      if (s == 0)
+        cairo_move_to(cr, OPS_X(perf_n[s]), OPS_Y(v));
+      else
+        cairo_line_to(cr, OPS_X(perf_n[s]), OPS_Y(v));
+    }
+    cairo_stroke(cr);
+    for (int s = 0; s < perf_done[a]; s++) {
+      double v = ops_value(&perf_ops[a][s], metric);
+      cairo_arc(cr, OPS_X(perf_n[s]), OPS_Y(v), 6, 0, 2 * M_PI);
+      cairo_fill(cr);
+    }
+  }
+#undef OPS_X
+#undef OPS_Y
+}
+
+static void draw_scaling(cairo_t *cr, int w, int h) {
+  int m = 60; // Margin
+  int gw = w - 2 * m;
+  int gh = h - 2 * m;
+  int max_t = scale_threads[scale_count - 1];
+  double x_step = (double)gw / (max_t > 1 ? max_t - 1 : 1);
+  double max_s = max_t;
+  for (int i = 1; i < scale_done; i++)
+    if (scale_ms[0] / scale_ms[i] > max_s)
+      max_s = scale_ms[0] / scale_ms[i];
+
+  // Axes
+  cairo_set_source_rgb(cr, 0.1, 0.1, 0.1);
+  cairo_set_line_width(cr, 2);
+  cairo_move_to(cr, m, h - m);
+  cairo_line_to(cr, w - m, h - m);
+  cairo_move_to(cr, m, h - m);
+  cairo_line_to(cr, m, m);
+  cairo_stroke(cr);
+
+  cairo_set_font_size(cr, 12);
+  for (int i = 0; i < scale_count; i++) {
+    double x = m + (scale_threads[i] - 1) * x_step;
+    char buf[32];
+    sprintf(buf, "%d", scale_threads[i]);
+    cairo_set_source_rgb(cr, 0.4, 0.4, 0.4);
+    cairo_move_to(cr, x - 5, h - m + 20);
+    cairo_show_text(cr, buf);
+  }
+  for (int i = 0; i <= 5; i++) {
+    double y = (h - m) - (i * gh / 5.0);
+    char buf[32];
+    sprintf(buf, "x%.1f", i * max_s / 5.0);
+    cairo_move_to(cr, 10, y + 4);
+    cairo_show_text(cr, buf);
+  }
+
+  cairo_set_source_rgb(cr, 0, 0, 0);
+  cairo_move_to(cr, w / 2 - 40, h - 20);
+  cairo_show_text(cr, "Threads");
+  cairo_set_font_size(cr, 16);
+  char title[96];
+  sprintf(title, "Acceleration du tri parallele (n = %d)", scale_n);
+  cairo_move_to(cr, w / 2 - 160, 30);
+  cairo_show_text(cr, title);
+
+  // Ideal speedup
+  double dash[] = {8.0, 6.0};
+  cairo_set_source_rgb(cr, 0.6, 0.6, 0.6);
+  cairo_set_line_width(cr, 2);
+  cairo_set_dash(cr, dash, 2, 0);
+  cairo_move_to(cr, m, (h - m) - (1.0 / max_s) * gh);
+  cairo_line_to(cr, w - m, (h - m) - (max_t / max_s) * gh);
+  cairo_stroke(cr);
+  cairo_set_dash(cr, NULL, 0, 0);
+
+  // Measured speedup
+  cairo_set_source_rgb(cr, 0.6, 0, 0.8);
+  cairo_set_line_width(cr, 4);
+  cairo_new_path(cr);
+  for (int i = 0; i < scale_done; i++) {
+    double x = m + (scale_threads[i] - 1) * x_step;
+    double y = (h - m) - (scale_ms[0] / scale_ms[i] / max_s) * gh;
+    if (i == 0)
+      cairo_move_to(cr, x, y);
+    else
+      cairo_line_to(cr, x, y);
+  }
+  cairo_stroke(cr);
+  for (int i = 0; i < scale_done; i++) {
+    double x = m + (scale_threads[i] - 1) * x_step;
+    double y = (h - m) - (scale_ms[0] / scale_ms[i] / max_s) * gh;
+    cairo_arc(cr, x, y, 6, 0, 2 * M_PI);
+    cairo_fill(cr);
+  }
+}
+
 static void draw_viz(GtkDrawingArea *area, cairo_t *cr, int w, int h,
                      gpointer data) {
   cairo_set_source_rgb(cr, 1, 1, 1);
   cairo_paint(cr);
 
-  if (graph_ready && perf_times[0]) {
+  int metric = gtk_combo_box_get_active(GTK_COMBO_BOX(combo_metric));
+  if (graph_ready && graph_scaling) {
+    draw_scaling(cr, w, h);
+  } else if (graph_ready && metric > 0 && perf_have_ops) {
+    draw_ops(cr, w, h, metric);
+  } else if (graph_ready && metric > 0) {
+    cairo_set_source_rgb(cr, 0.4, 0.4, 0.4);
+    cairo_set_font_size(cr, 14);
+    cairo_move_to(cr, w / 2 - 200, h / 2);
+    cairo_show_text(cr, "Relancez 'Comparer' pour compter les operations");
+  } else if (graph_ready && perf_times[0]) {
     // Draw Curves
     double max_t = 0.0001;
-    for (int a = 0; a < 4; a++)
-      for (int s = 0; s < perf_samples; s++)
-        if (perf_times[a][s] > max_t)
-          max_t = perf_times[a][s];
+    for (int a = 0; a < sort_kernel_count; a++)
+      for (int s = 0; s < perf_done[a]; s++) {
+        if (perf_p95[a][s] > max_t)
+          max_t = perf_p95[a][s];
+        if (perf_show_boxed && perf_boxed[a][s] > max_t)
+          max_t = perf_boxed[a][s];
+      }
+    // Log-log axes: whole decades around the measured range
+    double min_t = max_t;
+    for (int a = 0; a < sort_kernel_count; a++)
+      for (int s = 0; s < perf_done[a]; s++)
+        if (perf_min[a][s] > 0 && perf_min[a][s] < min_t)
+          min_t = perf_min[a][s];
+    for (int a = 0; baseline && a < sort_kernel_count; a++)
+      for (int s = 0; s < perf_samples; s++) {
+        const BenchRecord *r = baseline_find(a, perf_n[s]);
+        if (r && r->st.median > max_t)
+          max_t = r->st.median;
+        if (r && r->st.median < min_t)
+          min_t = r->st.median;
+      }
+    int lo_dec = (int)floor(log10(min_t));
+    int hi_dec = (int)ceil(log10(max_t));
+    if (hi_dec <= lo_dec)
+      hi_dec = lo_dec + 1;
 
     int m = 60; // Margin
     int gw = w - 2 * m;
     int gh = h - 2 * m;
 
+// Screen Y of a time: linear, or log10 over [lo_dec, hi_dec]
+#define TIME_Y(t)                                                              \
+  (perf_log_axes                                                               \
+       ? (h - m) - (log10(fmax(t, min_t)) - lo_dec) / (hi_dec - lo_dec) * gh   \
+       : (h - m) - ((t) / max_t) * gh)
+
     // Grid & Scale
     cairo_set_source_rgb(cr, 0.9, 0.9, 0.9);
     cairo_set_line_width(cr, 1);
 
     // Y Grid
-    for (int i = 0; i <= 5; i++) {
-      double y = (h - m) - (i * gh / 5.0);
+    int y_lines = perf_log_axes ? hi_dec - lo_dec : 5;
+    for (int i = 0; i <= y_lines; i++) {
+      double y = (h - m) - (i * gh / (double)y_lines);
       cairo_move_to(cr, m, y);
       cairo_line_to(cr, w - m, y);
       cairo_stroke(cr);
 
       // Label Y
       char buf[32];
-      sprintf(buf, "%.2f", (i * max_t / 5.0));
+      if (perf_log_axes)
+        sprintf(buf, "%g", pow(10, lo_dec + i));
+      else
+        sprintf(buf, "%.2f", (i * max_t / 5.0));
       cairo_set_source_rgb(cr, 0.4, 0.4, 0.4);
       cairo_move_to(cr, 10, y + 4);
       cairo_show_text(cr, buf);
       cairo_set_source_rgb(cr, 0.9, 0.9, 0.9);
     }
 
-    // X Grid
-    for (int s = 0; s < perf_samples; s++) {
-      double x = m + s * (double)gw / (perf_samples - 1);
-      cairo_move_to(cr, x, m);
-      cairo_line_to(cr, x, h - m);
-      cairo_stroke(cr);
-
-      // Label X (Size)
-      int n = (s + 1) * (perf_benchmark_max_n / perf_samples);
-      char buf[32];
-      sprintf(buf, "%d", n);
-      cairo_set_source_rgb(cr, 0.4, 0.4, 0.4);
-      cairo_move_to(cr, x - 10, h - m + 20);
-      cairo_show_text(cr, buf);
-      cairo_set_source_rgb(cr, 0.9, 0.9, 0.9);
-    }
+    // X Grid and sizes
+    draw_size_axis(cr, h, m, gw, TRUE);
 
     // Axes
     cairo_set_source_rgb(cr, 0.1, 0.1, 0.1);
@@ -485,14 +1778,12 @@ static void draw_viz(GtkDrawingArea *area, cairo_t *cr, int w, int h,
     cairo_set_source_rgb(cr, 0, 0, 0);
     cairo_set_font_size(cr, 16);
     cairo_move_to(cr, w / 2 - 140, 30);
-    cairo_show_text(cr, "Temps d'execution vs Taille");
+    cairo_show_text(cr, perf_log_axes ? "Temps d'execution vs Taille (log-log)"
+                                      : "Temps d'execution vs Taille");
 
-    double col[4][3] = {
-        {0, 0, 1}, {1, 0.5, 0}, {0, 0.8, 0}, {1, 0, 0}}; // B, Org, Grn, Red
-    const char *nms[] = {"Bulle", "Insertion", "Shell", "Rapide"};
-
-    for (int a = 0; a < 4; a++) {
-      cairo_set_source_rgb(cr, col[a][0], col[a][1], col[a][2]);
+    for (int a = 0; a < sort_kernel_count; a++) {
+      cairo_set_source_rgb(cr, curve_col[a][0], curve_col[a][1],
+                           curve_col[a][2]);
       // Increased line width for visibility
       cairo_set_line_width(cr, 4);
 
@@ -500,13 +1791,22 @@ static void draw_viz(GtkDrawingArea *area, cairo_t *cr, int w, int h,
       cairo_rectangle(cr, w - 120, 50 + a * 25, 15, 15);
       cairo_fill(cr);
       cairo_move_to(cr, w - 90, 62 + a * 25);
-      cairo_show_text(cr, nms[a]);
+      BenchFit fit;
+      if (curve_fit(a, &fit)) {
+        // Fitted exponent of t = a.n^b next to the name
+        char label[96];
+        snprintf(label, sizeof(label), "%s  n^%.2f", sort_kernels[a].name,
+                 fit.b);
+        cairo_show_text(cr, label);
+      } else {
+        cairo_show_text(cr, sort_kernels[a].name);
+      }
 
-      // Curve
+      // Curve (only the samples the worker has delivered so far)
       cairo_new_path(cr);
-      for (int s = 0; s < perf_samples; s++) {
-        double x = m + s * (double)gw / (perf_samples - 1);
-        double y = (h - m) - (perf_times[a][s] / max_t) * gh;
+      for (int s = 0; s < perf_done[a]; s++) {
+        double x = size_x(perf_n[s], m, gw);
+        double y = TIME_Y(perf_times[a][s]);
         if (s == 0)
           cairo_move_to(cr, x, y);
         else
@@ -515,13 +1815,91 @@ static void draw_viz(GtkDrawingArea *area, cairo_t *cr, int w, int h,
       cairo_stroke(cr);
 
       // Points (More visible)
-      for (int s = 0; s < perf_samples; s++) {
-        double x = m + s * (double)gw / (perf_samples - 1);
-        double y = (h - m) - (perf_times[a][s] / max_t) * gh;
+      for (int s = 0; s < perf_done[a]; s++) {
+        double x = size_x(perf_n[s], m, gw);
+        double y = TIME_Y(perf_times[a][s]);
         cairo_arc(cr, x, y, 6, 0, 2 * M_PI); // Larger radius 6
         cairo_fill(cr);
       }
+
+      // Error bars: spread of the repeated runs, min to p95
+      cairo_set_line_width(cr, 1.5);
+      for (int s = 0; s < perf_done[a]; s++) {
+        double x = size_x(perf_n[s], m, gw);
+        double y0 = TIME_Y(perf_min[a][s]);
+        double y1 = TIME_Y(perf_p95[a][s]);
+        cairo_move_to(cr, x, y0);
+        cairo_line_to(cr, x, y1);
+        cairo_move_to(cr, x - 5, y0);
+        cairo_line_to(cr, x + 5, y0);
+        cairo_move_to(cr, x - 5, y1);
+        cairo_line_to(cr, x + 5, y1);
+      }
+      cairo_stroke(cr);
+
+      // Boxed baseline (void**), same colour, dashed
+      if (perf_show_boxed && perf_done[a] > 0 && perf_boxed[a][0] >= 0) {
+        double dash[] = {8.0, 6.0};
+        cairo_set_line_width(cr, 2);
+        cairo_set_dash(cr, dash, 2, 0);
+        cairo_new_path(cr);
+        for (int s = 0; s < perf_done[a]; s++) {
+          double x = size_x(perf_n[s], m, gw);
+          double y = TIME_Y(perf_boxed[a][s]);
+          if (s == 0)
+            cairo_move_to(cr, x, y);
+          else
+            cairo_line_to(cr, x, y);
+        }
+        cairo_stroke(cr);
+        cairo_set_dash(cr, NULL, 0, 0);
+      }
+
+      // Baseline at the same sizes: same colour, dotted; points slower than
+      // it past the threshold circled in red
+      if (baseline) {
+        double dots[] = {2.0, 4.0};
+        cairo_set_line_width(cr, 2);
+        cairo_set_dash(cr, dots, 2, 0);
+        cairo_new_path(cr);
+        for (int s = 0; s < perf_samples; s++) {
+          const BenchRecord *r = baseline_find(a, perf_n[s]);
+          if (!r)
+            continue;
+          double x = size_x(perf_n[s], m, gw);
+          if (cairo_has_current_point(cr))
+            cairo_line_to(cr, x, TIME_Y(r->st.median));
+          else
+            cairo_move_to(cr, x, TIME_Y(r->st.median));
+        }
+        cairo_stroke(cr);
+        cairo_set_dash(cr, NULL, 0, 0);
+
+        double limit = regress_limit();
+        cairo_set_source_rgb(cr, 0.9, 0, 0);
+        for (int s = 0; s < perf_done[a]; s++)
+          if (baseline_ratio(a, s) > limit) {
+            double x = size_x(perf_n[s], m, gw);
+            double y = TIME_Y(perf_times[a][s]);
+            cairo_new_sub_path(cr);
+            cairo_arc(cr, x, y, 11, 0, 2 * M_PI);
+          }
+        cairo_stroke(cr);
+      }
     }
+
+    int legend_y = 62 + sort_kernel_count * 25;
+    cairo_set_source_rgb(cr, 0.3, 0.3, 0.3);
+    if (perf_show_boxed) {
+      cairo_move_to(cr, w - 120, legend_y);
+      cairo_show_text(cr, "- - void**");
+      legend_y += 20;
+    }
+    if (baseline) {
+      cairo_move_to(cr, w - 120, legend_y);
+      cairo_show_text(cr, ". . . reference (o: regression)");
+    }
+#undef TIME_Y
   } else {
     cairo_set_source_rgb(cr, 0.4, 0.4, 0.4);
     cairo_set_font_size(cr, 14);
@@ -536,10 +1914,15 @@ GtkWidget *create_sorting_view(AppContext *ctx) {
   GtkWidget *all = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 0);
 
   // --- 1. Left Sidebar (Configuration) ---
+  // Scrolls vertically: the frames below are taller than small screens
+  GtkWidget *left_scroll = gtk_scrolled_window_new();
+  gtk_scrolled_window_set_policy(GTK_SCROLLED_WINDOW(left_scroll),
+                                 GTK_POLICY_NEVER, GTK_POLICY_AUTOMATIC);
+  gtk_box_append(GTK_BOX(all), left_scroll);
   GtkWidget *left = gtk_box_new(GTK_ORIENTATION_VERTICAL, 10);
   gtk_widget_set_size_request(left, 300, -1);
   gtk_widget_add_css_class(left, "sidebar"); // CSS Class
-  gtk_box_append(GTK_BOX(all), left);
+  gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(left_scroll), left);
 
   // Title
   GtkWidget *lbl_conf = gtk_label_new("Configuration");
@@ -564,6 +1947,32 @@ GtkWidget *create_sorting_view(AppContext *ctx) {
   gtk_frame_set_child(GTK_FRAME(f2), combo_type);
   gtk_box_append(GTK_BOX(left), f2);
 
+  // Frame: Distribution (text data and benchmark input)
+  GtkWidget *f_di = gtk_frame_new("Distribution des donnees");
+  combo_dist = gtk_combo_box_text_new();
+  for (int d = 0; d < DIST_COUNT; d++)
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo_dist),
+                                   bench_dist_name(d));
+  gtk_combo_box_set_active(GTK_COMBO_BOX(combo_dist), DIST_UNIFORM);
+  // Presortedness of "Presque trie": swaps as a percentage of N
+  GtkWidget *b_di = gtk_box_new(GTK_ORIENTATION_VERTICAL, 2);
+  GtkWidget *b_ds = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
+  spin_disorder = gtk_spin_button_new_with_range(0, 100, 0.1);
+  gtk_spin_button_set_digits(GTK_SPIN_BUTTON(spin_disorder), 2);
+  gtk_spin_button_set_value(GTK_SPIN_BUTTON(spin_disorder), 1.0);
+  gtk_box_append(GTK_BOX(b_ds), gtk_label_new("Desordre (% echanges)"));
+  gtk_box_append(GTK_BOX(b_ds), spin_disorder);
+  // Seed of generated data and benchmark input, 0 = a new one each time
+  GtkWidget *b_sd = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
+  spin_seed = gtk_spin_button_new_with_range(0, 4294967295.0, 1);
+  gtk_box_append(GTK_BOX(b_sd), gtk_label_new("Graine (0 = nouvelle)"));
+  gtk_box_append(GTK_BOX(b_sd), spin_seed);
+  gtk_box_append(GTK_BOX(b_di), combo_dist);
+  gtk_box_append(GTK_BOX(b_di), b_ds);
+  gtk_box_append(GTK_BOX(b_di), b_sd);
+  gtk_frame_set_child(GTK_FRAME(f_di), b_di);
+  gtk_box_append(GTK_BOX(left), f_di);
+
   // Frame: Algo Text
   GtkWidget *f4 = gtk_frame_new("Algorithme (Pour Tri Texte)");
   combo_algo = gtk_combo_box_text_new();
@@ -571,10 +1980,160 @@ GtkWidget *create_sorting_view(AppContext *ctx) {
   gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo_algo), "Insertion");
   gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo_algo), "Shell");
   gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo_algo), "Rapide");
+  gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo_algo), "Introsort");
+  gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo_algo),
+                                 "Radix (LSD, chaines: MSD)");
+  gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo_algo), "Parallele");
+  gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo_algo), "SIMD (AVX2)");
+  gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo_algo), "TimSort");
+  gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo_algo),
+                                 "Quick bloc (sans branche)");
   gtk_combo_box_set_active(GTK_COMBO_BOX(combo_algo), 0);
   gtk_frame_set_child(GTK_FRAME(f4), combo_algo);
   gtk_box_append(GTK_BOX(left), f4);
 
+  // Frame: Selection (k first values instead of a full sort)
+  GtkWidget *f_se = gtk_frame_new("Selection (k premiers, 0 = mediane)");
+  GtkWidget *b_se = gtk_box_new(GTK_ORIENTATION_VERTICAL, 2);
+  GtkWidget *b_sk = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
+  combo_select = gtk_combo_box_text_new();
+  for (int m = 0; m < SELECT_COUNT; m++)
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo_select),
+                                   select_names[m]);
+  gtk_combo_box_set_active(GTK_COMBO_BOX(combo_select), SELECT_TOP_K);
+  spin_k = gtk_spin_button_new_with_range(0, 1000000000, 1);
+  gtk_spin_button_set_value(GTK_SPIN_BUTTON(spin_k), 10);
+  GtkWidget *btn_select = gtk_button_new_with_label("Selectionner");
+  g_signal_connect(btn_select, "clicked", G_CALLBACK(on_select), NULL);
+  gtk_box_append(GTK_BOX(b_sk), spin_k);
+  gtk_box_append(GTK_BOX(b_sk), btn_select);
+  gtk_box_append(GTK_BOX(b_se), combo_select);
+  gtk_box_append(GTK_BOX(b_se), b_sk);
+  gtk_frame_set_child(GTK_FRAME(f_se), b_se);
+  gtk_box_append(GTK_BOX(left), f_se);
+
+  // Frame: Threads (parallel sort)
+  GtkWidget *f_th = gtk_frame_new("Threads (tri parallele)");
+  spin_threads = gtk_spin_button_new_with_range(1, PAR_MAX_THREADS, 1);
+  gtk_spin_button_set_value(GTK_SPIN_BUTTON(spin_threads),
+                            parallel_default_threads());
+  parallel_set_threads(parallel_default_threads());
+  g_signal_connect(spin_threads, "value-changed",
+                   G_CALLBACK(on_threads_changed), NULL);
+  gtk_frame_set_child(GTK_FRAME(f_th), spin_threads);
+  gtk_box_append(GTK_BOX(left), f_th);
+
+  // Frame: Shell sort gap sequence
+  GtkWidget *f_ga = gtk_frame_new("Ecarts (tri Shell)");
+  GtkWidget *b_ga = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
+  combo_gaps = gtk_combo_box_text_new();
+  for (int seq = 0; seq < GAPS_COUNT; seq++)
+    gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo_gaps),
+                                   shell_gaps_name(seq));
+  gtk_combo_box_set_active(GTK_COMBO_BOX(combo_gaps), shell_get_gaps());
+  g_signal_connect(combo_gaps, "changed", G_CALLBACK(on_gaps_changed), NULL);
+  btn_gaps = gtk_button_new_with_label("Comparer les ecarts");
+  g_signal_connect(btn_gaps, "clicked", G_CALLBACK(on_compare_gaps), NULL);
+  gtk_box_append(GTK_BOX(b_ga), combo_gaps);
+  gtk_box_append(GTK_BOX(b_ga), btn_gaps);
+  gtk_frame_set_child(GTK_FRAME(f_ga), b_ga);
+  gtk_box_append(GTK_BOX(left), f_ga);
+
+  // Frame: Mesures (warmup + repeated timed runs per point)
+  GtkWidget *f_me = gtk_frame_new("Mesures (echauffement / repetitions)");
+  GtkWidget *b_me = gtk_box_new(GTK_ORIENTATION_VERTICAL, 2);
+  GtkWidget *b_sp = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
+  spin_warmup = gtk_spin_button_new_with_range(0, 10, 1);
+  gtk_spin_button_set_value(GTK_SPIN_BUTTON(spin_warmup), 1);
+  spin_repeats = gtk_spin_button_new_with_range(1, 50, 1);
+  gtk_spin_button_set_value(GTK_SPIN_BUTTON(spin_repeats), 5);
+  gtk_box_append(GTK_BOX(b_sp), spin_warmup);
+  gtk_box_append(GTK_BOX(b_sp), spin_repeats);
+  check_counters =
+      gtk_check_button_new_with_label("Compteurs materiels (perf_event)");
+  gtk_box_append(GTK_BOX(b_me), b_sp);
+  gtk_box_append(GTK_BOX(b_me), check_counters);
+  gtk_frame_set_child(GTK_FRAME(f_me), b_me);
+  gtk_box_append(GTK_BOX(left), f_me);
+
+  // Frame: Balayage (sizes measured by "Comparer")
+  GtkWidget *f_sw = gtk_frame_new("Balayage (2^min, 2^max, points/octave)");
+  GtkWidget *b_sw = gtk_box_new(GTK_ORIENTATION_VERTICAL, 2);
+  GtkWidget *b_sn = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
+  combo_sweep = gtk_combo_box_text_new();
+  gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo_sweep),
+                                 "Lineaire: 4 tailles jusqu'a N");
+  gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo_sweep),
+                                 "Geometrique (log-log, ajustement)");
+  gtk_combo_box_set_active(GTK_COMBO_BOX(combo_sweep), 0);
+  spin_sweep_lo = gtk_spin_button_new_with_range(4, 26, 1);
+  gtk_spin_button_set_value(GTK_SPIN_BUTTON(spin_sweep_lo), 8);
+  spin_sweep_hi = gtk_spin_button_new_with_range(4, 26, 1);
+  gtk_spin_button_set_value(GTK_SPIN_BUTTON(spin_sweep_hi), 20);
+  spin_sweep_steps = gtk_spin_button_new_with_range(1, 4, 1);
+  gtk_spin_button_set_value(GTK_SPIN_BUTTON(spin_sweep_steps), 2);
+  gtk_box_append(GTK_BOX(b_sn), spin_sweep_lo);
+  gtk_box_append(GTK_BOX(b_sn), spin_sweep_hi);
+  gtk_box_append(GTK_BOX(b_sn), spin_sweep_steps);
+  gtk_box_append(GTK_BOX(b_sw), combo_sweep);
+  gtk_box_append(GTK_BOX(b_sw), b_sn);
+  gtk_frame_set_child(GTK_FRAME(f_sw), b_sw);
+  gtk_box_append(GTK_BOX(left), f_sw);
+
+  // Frame: Resultats (export, baseline and regression threshold)
+  GtkWidget *f_rs = gtk_frame_new("Resultats (export, reference, seuil %)");
+  GtkWidget *b_rs = gtk_box_new(GTK_ORIENTATION_VERTICAL, 2);
+  GtkWidget *b_rb = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
+  GtkWidget *btn_export = gtk_button_new_with_label("Exporter...");
+  g_signal_connect(btn_export, "clicked", G_CALLBACK(on_export), NULL);
+  GtkWidget *btn_baseline = gtk_button_new_with_label("Reference...");
+  g_signal_connect(btn_baseline, "clicked", G_CALLBACK(on_baseline), NULL);
+  GtkWidget *btn_no_baseline = gtk_button_new_with_label("Aucune");
+  g_signal_connect(btn_no_baseline, "clicked", G_CALLBACK(on_baseline_clear),
+                   NULL);
+  spin_regress = gtk_spin_button_new_with_range(1, 200, 1);
+  gtk_spin_button_set_value(GTK_SPIN_BUTTON(spin_regress), 10);
+  g_signal_connect(spin_regress, "value-changed",
+                   G_CALLBACK(on_regress_changed), NULL);
+  gtk_box_append(GTK_BOX(b_rb), btn_export);
+  gtk_box_append(GTK_BOX(b_rb), btn_baseline);
+  gtk_box_append(GTK_BOX(b_rb), btn_no_baseline);
+  gtk_box_append(GTK_BOX(b_rs), b_rb);
+  gtk_box_append(GTK_BOX(b_rs), spin_regress);
+  gtk_frame_set_child(GTK_FRAME(f_rs), b_rs);
+  gtk_box_append(GTK_BOX(left), f_rs);
+
+  // Frame: Stockage
+  GtkWidget *f_st = gtk_frame_new("Stockage");
+  GtkWidget *b_st = gtk_box_new(GTK_ORIENTATION_VERTICAL, 2);
+  combo_storage = gtk_combo_box_text_new();
+  gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo_storage),
+                                 "Contigu (type)");
+  gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo_storage),
+                                 "Pointeurs void** (reference)");
+  gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo_storage),
+                                 "Pointeurs void** (arene)");
+  gtk_combo_box_set_active(GTK_COMBO_BOX(combo_storage), 0);
+  check_boxed_graph =
+      gtk_check_button_new_with_label("Graphe: ajouter void** (pointilles)");
+  gtk_box_append(GTK_BOX(b_st), combo_storage);
+  gtk_box_append(GTK_BOX(b_st), check_boxed_graph);
+  combo_metric = gtk_combo_box_text_new();
+  gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo_metric),
+                                 "Graphe: temps (ms)");
+  gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo_metric),
+                                 "Graphe: comparaisons");
+  gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo_metric),
+                                 "Graphe: echanges");
+  gtk_combo_box_text_append_text(GTK_COMBO_BOX_TEXT(combo_metric),
+                                 "Graphe: deplacements");
+  gtk_combo_box_set_active(GTK_COMBO_BOX(combo_metric), 0);
+  g_signal_connect(combo_metric, "changed", G_CALLBACK(on_metric_changed),
+                   NULL);
+  gtk_box_append(GTK_BOX(b_st), combo_metric);
+  gtk_frame_set_child(GTK_FRAME(f_st), b_st);
+  gtk_box_append(GTK_BOX(left), f_st);
+
   // Frame: Ordre
   GtkWidget *f5 = gtk_frame_new("Ordre Final");
   GtkWidget *b5 = gtk_box_new(GTK_ORIENTATION_VERTICAL, 2);
@@ -588,12 +2147,30 @@ GtkWidget *create_sorting_view(AppContext *ctx) {
   gtk_frame_set_child(GTK_FRAME(f5), b5);
   gtk_box_append(GTK_BOX(left), f5);
 
-  // Frame Stats
-  GtkWidget *f6 = gtk_frame_new("Comparaison de temps");
-  label_stats = gtk_label_new("...");
-  gtk_widget_add_css_class(label_stats, "stat");
-  gtk_frame_set_child(GTK_FRAME(f6), label_stats);
-  gtk_box_append(GTK_BOX(left), f6);
+  // Frame: Fichier (mmap load into the sort buffer, save after sorting)
+  GtkWidget *f_fi = gtk_frame_new("Fichier (Entier / Reel)");
+  GtkWidget *b_fi = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
+  GtkWidget *btn_load_file = gtk_button_new_with_label("Charger...");
+  g_signal_connect(btn_load_file, "clicked", G_CALLBACK(on_load_file), NULL);
+  GtkWidget *btn_save_file = gtk_button_new_with_label("Enregistrer...");
+  g_signal_connect(btn_save_file, "clicked", G_CALLBACK(on_save_file), NULL);
+  gtk_box_append(GTK_BOX(b_fi), btn_load_file);
+  gtk_box_append(GTK_BOX(b_fi), btn_save_file);
+  gtk_frame_set_child(GTK_FRAME(f_fi), b_fi);
+  gtk_box_append(GTK_BOX(left), f_fi);
+
+  // Frame: Tri externe (files larger than RAM)
+  GtkWidget *f_ex = gtk_frame_new("Tri externe (fichier binaire)");
+  GtkWidget *b_ex = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
+  spin_ext_mem = gtk_spin_button_new_with_range(16, 65536, 16);
+  gtk_spin_button_set_value(GTK_SPIN_BUTTON(spin_ext_mem), 256);
+  gtk_widget_set_tooltip_text(spin_ext_mem, "Memoire de travail (Mo)");
+  btn_ext_sort = gtk_button_new_with_label("Trier un fichier...");
+  g_signal_connect(btn_ext_sort, "clicked", G_CALLBACK(on_ext_sort), NULL);
+  gtk_box_append(GTK_BOX(b_ex), spin_ext_mem);
+  gtk_box_append(GTK_BOX(b_ex), btn_ext_sort);
+  gtk_frame_set_child(GTK_FRAME(f_ex), b_ex);
+  gtk_box_append(GTK_BOX(left), f_ex);
 
   // --- 2. Main Right Panel ---
   GtkWidget *right = gtk_box_new(GTK_ORIENTATION_VERTICAL, 10);
@@ -624,16 +2201,33 @@ GtkWidget *create_sorting_view(AppContext *ctx) {
   g_signal_connect(btn_2, "clicked", G_CALLBACK(on_sort_text_only), NULL);
   gtk_box_append(GTK_BOX(top_bar), btn_2);
 
-  GtkWidget *btn_3 = gtk_button_new_with_label("3. Comparer (Stats Graph)");
-  gtk_widget_add_css_class(btn_3, "btn-primary");
-  g_signal_connect(btn_3, "clicked", G_CALLBACK(on_compare), NULL);
-  gtk_box_append(GTK_BOX(top_bar), btn_3);
+  btn_compare = gtk_button_new_with_label("3. Comparer (Stats Graph)");
+  gtk_widget_add_css_class(btn_compare, "btn-primary");
+  g_signal_connect(btn_compare, "clicked", G_CALLBACK(on_compare), NULL);
+  gtk_box_append(GTK_BOX(top_bar), btn_compare);
+
+  btn_scaling = gtk_button_new_with_label("4. Scalabilite (threads)");
+  gtk_widget_add_css_class(btn_scaling, "btn-primary");
+  g_signal_connect(btn_scaling, "clicked", G_CALLBACK(on_scaling), NULL);
+  gtk_box_append(GTK_BOX(top_bar), btn_scaling);
+
+  btn_cancel = gtk_button_new_with_label("Annuler");
+  gtk_widget_add_css_class(btn_cancel, "btn-warning");
+  gtk_widget_set_sensitive(btn_cancel, FALSE);
+  g_signal_connect(btn_cancel, "clicked", G_CALLBACK(on_cancel), NULL);
+  gtk_box_append(GTK_BOX(top_bar), btn_cancel);
 
   GtkWidget *btn_rst = gtk_button_new_with_label("Réinitialiser");
   gtk_widget_add_css_class(btn_rst, "btn-danger");
   g_signal_connect(btn_rst, "clicked", G_CALLBACK(on_reset), NULL);
   gtk_box_append(GTK_BOX(top_bar), btn_rst);
 
+  // Benchmark progress
+  progress_bench = gtk_progress_bar_new();
+  gtk_progress_bar_set_show_text(GTK_PROGRESS_BAR(progress_bench), TRUE);
+  gtk_progress_bar_set_text(GTK_PROGRESS_BAR(progress_bench), "");
+  gtk_box_append(GTK_BOX(right), progress_bench);
+
   // Middle Text Views
   GtkWidget *paned = gtk_paned_new(GTK_ORIENTATION_VERTICAL);
   gtk_widget_set_size_request(paned, -1,
@@ -643,9 +2237,7 @@ GtkWidget *create_sorting_view(AppContext *ctx) {
   // Before
   GtkWidget *sc1 = gtk_scrolled_window_new();
   gtk_widget_set_size_request(sc1, -1, 280); // Increased individual text height
-  text_before = gtk_text_view_new();
-  gtk_text_view_set_editable(GTK_TEXT_VIEW(text_before), FALSE);
-  gtk_text_view_set_wrap_mode(GTK_TEXT_VIEW(text_before), GTK_WRAP_WORD);
+  text_before = typed_view_new();
   gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(sc1), text_before);
 
   GtkWidget *fr_b = gtk_frame_new("Données Initiales");
@@ -656,9 +2248,7 @@ GtkWidget *create_sorting_view(AppContext *ctx) {
   // After
   GtkWidget *sc2 = gtk_scrolled_window_new();
   gtk_widget_set_size_request(sc2, -1, 80);
-  text_after = gtk_text_view_new();
-  gtk_text_view_set_editable(GTK_TEXT_VIEW(text_after), FALSE);
-  gtk_text_view_set_wrap_mode(GTK_TEXT_VIEW(text_after), GTK_WRAP_WORD);
+  text_after = typed_view_new();
   gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(sc2), text_after);
 
   GtkWidget *fr_a = gtk_frame_new("Après Tri");
@@ -666,12 +2256,32 @@ GtkWidget *create_sorting_view(AppContext *ctx) {
   gtk_paned_set_end_child(GTK_PANED(paned), fr_a);
   gtk_paned_set_resize_end_child(GTK_PANED(paned), TRUE);
 
-  // Bottom Graph
+  // Bottom: graph, and the stats beside it in their own scrolled pane (one
+  // line per algorithm for timings, fits, counters, regressions...)
+  GtkWidget *bottom = gtk_paned_new(GTK_ORIENTATION_HORIZONTAL);
+  gtk_widget_set_vexpand(bottom, TRUE);
+  gtk_box_append(GTK_BOX(right), bottom);
+
   drawing_area = gtk_drawing_area_new();
   gtk_widget_set_vexpand(drawing_area, TRUE);
   gtk_drawing_area_set_draw_func(GTK_DRAWING_AREA(drawing_area), draw_viz, NULL,
                                  NULL);
-  gtk_box_append(GTK_BOX(right), drawing_area);
+  gtk_paned_set_start_child(GTK_PANED(bottom), drawing_area);
+  gtk_paned_set_resize_start_child(GTK_PANED(bottom), TRUE);
+
+  // Frame Stats
+  GtkWidget *sc_stats = gtk_scrolled_window_new();
+  gtk_widget_set_size_request(sc_stats, 320, -1);
+  label_stats = gtk_label_new("...");
+  gtk_widget_add_css_class(label_stats, "stat");
+  gtk_label_set_xalign(GTK_LABEL(label_stats), 0.0);
+  gtk_label_set_yalign(GTK_LABEL(label_stats), 0.0);
+  gtk_label_set_selectable(GTK_LABEL(label_stats), TRUE);
+  gtk_scrolled_window_set_child(GTK_SCROLLED_WINDOW(sc_stats), label_stats);
+  GtkWidget *f6 = gtk_frame_new("Comparaison de temps");
+  gtk_frame_set_child(GTK_FRAME(f6), sc_stats);
+  gtk_paned_set_end_child(GTK_PANED(bottom), f6);
+  gtk_paned_set_resize_end_child(GTK_PANED(bottom), FALSE);
 
   return all;
 }
@@ -1,4 +1,5 @@
 #include "app.h"
+#include "rng.h"
 #include <ctype.h>
 #include <string.h>
 
@@ -50,6 +51,7 @@ static GtkWidget *combo_dtype;
 static GtkWidget *entry_size;
 static GtkWidget *combo_mode;      // Aléatoire / Manuel
 static GtkWidget *entry_manual;    // Manual input string
+static GtkWidget *spin_seed;       // Generation seed, 0 draws a new one
 static GtkWidget *combo_traversal; // Profondeur/Largeur
 static GtkWidget *combo_order;     // Pre/In/Post
 static GtkWidget *drawing_area;
@@ -199,6 +201,11 @@ static void generate_tree() {
 
   TNode **nodes = NULL;
   int size = 0;
+  // Values and shape both come from this seed
+  unsigned int seed = rng_seed_or_fresh(
+      (unsigned int)gtk_spin_button_get_value(GTK_SPIN_BUTTON(spin_seed)));
+  Rng rng;
+  rng_seed(&rng, seed);
 
   if (mode_idx == 1) { // Manuel
     const char *raw = gtk_editable_get_text(GTK_EDITABLE(entry_manual));
@@ -231,11 +238,12 @@ static void generate_tree() {
       void *d;
       if (current_dtype == TYPE_INT) {
         int *v = malloc(sizeof(int));
-        *v = rand() % 100 + 1;
+        *v = (int)rng_below(&rng, 100) + 1;
         d = v;
       } else if (current_dtype == TYPE_DOUBLE) {
         double *v = malloc(sizeof(double));
-        *v = rand() % 100 + ((rand() % 10) / 10.0);
+        int units = (int)rng_below(&rng, 100);
+        *v = units + rng_below(&rng, 10) / 10.0;
         d = v;
       } else {
         char b[10];
@@ -273,7 +281,7 @@ static void generate_tree() {
     */
     int added = 0;
     // Simple shuffle by iterating with offset
-    int start_chk = rand() % conn_count;
+    int start_chk = (int)rng_below(&rng, conn_count);
     for (int k = 0; k < conn_count; k++) {
       int idx = (start_chk + k) % conn_count;
       TNode *p = connected[idx];
@@ -293,7 +301,7 @@ static void generate_tree() {
   free(connected);
   free(nodes);
   assign_indices_bfs(root);
-  log_msg_tree("Arbre genere (%d noeuds).", size);
+  log_msg_tree("Arbre genere (%d noeuds, graine %u).", size, seed);
 
   // Start Animation
   visible_count = 0;
@@ -1014,6 +1022,14 @@ GtkWidget *create_tree_view(AppContext *ctx) {
   gtk_widget_set_visible(entry_manual, FALSE);
   gtk_box_append(GTK_BOX(bp), entry_manual);
 
+  // Seed of random trees (values and shape), 0 = a new one each time
+  GtkWidget *r_seed = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
+  gtk_box_append(GTK_BOX(r_seed), gtk_label_new("Graine (0 = nouvelle):"));
+  spin_seed = gtk_spin_button_new_with_range(0, 4294967295.0, 1);
+  gtk_widget_set_hexpand(spin_seed, TRUE);
+  gtk_box_append(GTK_BOX(r_seed), spin_seed);
+  gtk_box_append(GTK_BOX(bp), r_seed);
+
   // Row 4: Traversal
   GtkWidget *r4 = gtk_box_new(GTK_ORIENTATION_HORIZONTAL, 5);
   gtk_box_append(GTK_BOX(r4), gtk_label_new("Parcours:"));
@@ -0,0 +1,253 @@
+#include "typed_io.h"
+#include <ctype.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static size_t elem_size(DataType type) {
+  return type == TYPE_INT ? sizeof(int) : sizeof(double);
+}
+
+static int has_suffix(const char *s, const char *suffix) {
+  size_t n = strlen(s), k = strlen(suffix);
+  return n >= k && strcmp(s + n - k, suffix) == 0;
+}
+
+FileFormat typed_file_format_for(const char *path) {
+  return has_suffix(path, ".txt") || has_suffix(path, ".csv") ? FILE_TEXT
+                                                                : FILE_BINARY;
+}
+
+FileFormat typed_file_sniff(const char *path) {
+  FILE *f = fopen(path, "rb");
+  if (!f)
+    return FILE_BINARY;
+  unsigned char buf[4096];
+  size_t got = fread(buf, 1, sizeof(buf), f);
+  fclose(f);
+  // strchr also finds the terminating NUL: NUL bytes are tested first
+  for (size_t i = 0; i < got; i++)
+    if (!isdigit(buf[i]) && !isspace(buf[i]) &&
+        (buf[i] == '\0' || !strchr("+-.eE", buf[i])))
+      return FILE_BINARY;
+  return got > 0 ? FILE_TEXT : FILE_BINARY;
+}
+
+// --- Text Parsing ---
+
+// Lines holding a number: non-empty lines
+static long long count_values(const char *p, const char *end) {
+  long long count = 0;
+  while (p < end) {
+    const char *nl = memchr(p, '\n', end - p);
+    const char *line_end = nl ? nl : end;
+    for (const char *q = p; q < line_end; q++)
+      if (!isspace((unsigned char)*q)) {
+        count++;
+        break;
+      }
+    p = line_end + 1;
+  }
+  return count;
+}
+
+// Hand-rolled integer parser: strtol needs a NUL terminated buffer, which a
+// mapping does not have. NULL if the value does not fit in an int.
+static const char *parse_int(const char *p, const char *end, int *out) {
+  int neg = 0;
+  if (p < end && (*p == '-' || *p == '+'))
+    neg = *p++ == '-';
+  long long limit = neg ? -(long long)INT_MIN : INT_MAX;
+  long long v = 0;
+  while (p < end && *p >= '0' && *p <= '9') {
+    v = v * 10 + (*p++ - '0');
+    if (v > limit)
+      return NULL;
+  }
+  *out = (int)(neg ? -v : v);
+  return p;
+}
+
+// Copies the token to a small buffer so strtod stops inside the mapping
+static const char *parse_double(const char *p, const char *end, double *out) {
+  char tok[64];
+  int len = 0;
+  while (p < end && !isspace((unsigned char)*p) && len < 63)
+    tok[len++] = *p++;
+  tok[len] = '\0';
+  *out = strtod(tok, NULL);
+  while (p < end && !isspace((unsigned char)*p))
+    p++;
+  return p;
+}
+
+// -1 on an int out of range
+static int parse_text(TypedArray *ta, const char *p, const char *end) {
+  for (int i = 0; i < ta->n && p < end;) {
+    if (isspace((unsigned char)*p)) {
+      p++;
+      continue;
+    }
+    if (ta->type == TYPE_INT)
+      p = parse_int(p, end, &ta->ints[i]);
+    else
+      p = parse_double(p, end, &ta->doubles[i]);
+    if (!p)
+      return -1;
+    i++;
+    // Rest of the line (e.g. a second CSV column) is ignored
+    const char *nl = memchr(p, '\n', end - p);
+    p = nl ? nl + 1 : end;
+  }
+  return 0;
+}
+
+// --- Load / Save ---
+
+int typed_file_load(TypedArray *ta, const char *path, DataType type,
+                    FileFormat fmt) {
+  if (type != TYPE_INT && type != TYPE_DOUBLE) {
+    errno = EINVAL;
+    return -1;
+  }
+  int fd = open(path, O_RDONLY);
+  if (fd < 0)
+    return -1;
+  struct stat sb;
+  if (fstat(fd, &sb) != 0) {
+    close(fd);
+    return -1;
+  }
+
+  size_t size = sb.st_size;
+  const char *map = NULL;
+  if (size > 0) {
+    map = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (map == MAP_FAILED) {
+      close(fd);
+      return -1;
+    }
+    madvise((void *)map, size, MADV_SEQUENTIAL);
+  }
+  close(fd); // The mapping stays valid
+
+  long long n = fmt == FILE_BINARY ? (long long)(size / elem_size(type))
+                                   : count_values(map, map + size);
+  int rc = 0;
+  if (n > INT_MAX) {
+    errno = EFBIG;
+    rc = -1;
+  } else {
+    // Parsed aside so a rejected file leaves ta as it was
+    TypedArray loaded;
+    typed_array_alloc(&loaded, type, (int)n, 0);
+    if (fmt == FILE_BINARY)
+      memcpy(type == TYPE_INT ? (void *)loaded.ints : (void *)loaded.doubles,
+             map, n * elem_size(type));
+    else if (parse_text(&loaded, map, map + size) != 0) {
+      errno = ERANGE;
+      rc = -1;
+    }
+    if (rc == 0) {
+      typed_array_free(ta);
+      *ta = loaded;
+    } else {
+      typed_array_free(&loaded);
+    }
+  }
+  if (map)
+    munmap((void *)map, size);
+  return rc;
+}
+
+// Binary: the output file is sized up front and filled through a shared
+// mapping, so the data is copied once straight into the page cache
+static int save_binary(const TypedArray *ta, const char *path) {
+  size_t size = (size_t)ta->n * elem_size(ta->type);
+  int fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0)
+    return -1;
+  if (size == 0)
+    return close(fd);
+  if (ftruncate(fd, size) != 0) {
+    close(fd);
+    return -1;
+  }
+  void *map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+  if (map == MAP_FAILED) {
+    close(fd);
+    return -1;
+  }
+  memcpy(map,
+         ta->type == TYPE_INT ? (void *)ta->ints : (void *)ta->doubles,
+         size);
+  int rc = munmap(map, size);
+  if (close(fd) != 0)
+    rc = -1;
+  return rc;
+}
+
+// Text: formatted into a large buffer, then written with fwrite
+static int save_text(const TypedArray *ta, const char *path) {
+  enum { BUF_SIZE = 1 << 20 };
+  // Allocated first so a failure leaves any existing file untouched
+  char *buf = malloc(BUF_SIZE);
+  if (!buf) {
+    errno = ENOMEM;
+    return -1;
+  }
+  FILE *f = fopen(path, "w");
+  if (!f) {
+    free(buf);
+    return -1;
+  }
+  size_t len = 0;
+  int rc = 0;
+  for (int i = 0; i < ta->n && rc == 0; i++) {
+    if (ta->type == TYPE_INT) {
+      // Digits backwards into a small buffer, faster than printf
+      char tmp[16];
+      int k = 0;
+      long long v = ta->ints[i];
+      int neg = v < 0;
+      if (neg)
+        v = -v;
+      do {
+        tmp[k++] = '0' + v % 10;
+        v /= 10;
+      } while (v);
+      if (neg)
+        buf[len++] = '-';
+      while (k)
+        buf[len++] = tmp[--k];
+      buf[len++] = '\n';
+    } else {
+      len += sprintf(buf + len, "%.17g\n", ta->doubles[i]);
+    }
+    if (len > BUF_SIZE - 64) {
+      if (fwrite(buf, 1, len, f) != len)
+        rc = -1;
+      len = 0;
+    }
+  }
+  if (rc == 0 && len && fwrite(buf, 1, len, f) != len)
+    rc = -1;
+  free(buf);
+  if (fclose(f) != 0)
+    rc = -1;
+  return rc;
+}
+
+int typed_file_save(const TypedArray *ta, const char *path, FileFormat fmt) {
+  if (ta->type != TYPE_INT && ta->type != TYPE_DOUBLE) {
+    errno = EINVAL;
+    return -1;
+  }
+  return fmt == FILE_BINARY ? save_binary(ta, path) : save_text(ta, path);
+}
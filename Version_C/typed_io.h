@@ -0,0 +1,29 @@
+#ifndef TYPED_IO_H
+#define TYPED_IO_H
+
+#include "typed_sort.h"
+
+// Numeric files into and out of a TypedArray through mmap, so large inputs
+// never go through the GTK text view. TYPE_INT and TYPE_DOUBLE only.
+// No GTK dependency.
+
+typedef enum {
+  FILE_BINARY, // Native ints or doubles back to back, no header
+  FILE_TEXT    // One decimal number per line
+} FileFormat;
+
+// Text when the first 4 KiB only hold digits, signs, '.', 'e' and
+// whitespace; binary otherwise
+FileFormat typed_file_sniff(const char *path);
+
+// Text for .txt/.csv names, binary otherwise (used when saving)
+FileFormat typed_file_format_for(const char *path);
+
+// Replaces ta with the file contents. Returns 0, or -1 with errno set
+// (EINVAL: unsupported type, EFBIG: more than INT_MAX values, ERANGE: a
+// text value out of the int range). ta is left unchanged on failure.
+int typed_file_load(TypedArray *ta, const char *path, DataType type,
+                    FileFormat fmt);
+int typed_file_save(const TypedArray *ta, const char *path, FileFormat fmt);
+
+#endif
@@ -0,0 +1,314 @@
+#include "typed_sort.h"
+#include "block_sort.h"
+#include "parallel_sort.h"
+#include "radix_sort.h"
+#include "simd_sort.h"
+#include "sort.h"
+#include "sort_gen.h"
+#include "string_sort.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define GT(a, b) ((a) > (b))
+#define LT(a, b) ((a) < (b))
+#define STR_GT(a, b) (strcmp((a), (b)) > 0)
+#define STR_LT(a, b) (strcmp((a), (b)) < 0)
+#define BOX_INT_GT(a, b) (*(int *)(a) > *(int *)(b))
+#define BOX_INT_LT(a, b) (*(int *)(a) < *(int *)(b))
+#define BOX_DOUBLE_GT(a, b) (*(double *)(a) > *(double *)(b))
+#define BOX_DOUBLE_LT(a, b) (*(double *)(a) < *(double *)(b))
+#define BOX_CHAR_GT(a, b) (*(char *)(a) > *(char *)(b))
+#define BOX_CHAR_LT(a, b) (*(char *)(a) < *(char *)(b))
+#define BOX_STR_GT(a, b) (strcmp((char *)(a), (char *)(b)) > 0)
+#define BOX_STR_LT(a, b) (strcmp((char *)(a), (char *)(b)) < 0)
+
+DEFINE_SORTS(int_asc, int, GT)
+DEFINE_SORTS(int_desc, int, LT)
+DEFINE_SORTS(double_asc, double, GT)
+DEFINE_SORTS(double_desc, double, LT)
+DEFINE_SORTS(char_asc, char, GT)
+DEFINE_SORTS(char_desc, char, LT)
+DEFINE_SORTS(str_asc, char *, STR_GT)
+DEFINE_SORTS(str_desc, char *, STR_LT)
+DEFINE_SORTS(box_int_asc, void *, BOX_INT_GT)
+DEFINE_SORTS(box_int_desc, void *, BOX_INT_LT)
+DEFINE_SORTS(box_double_asc, void *, BOX_DOUBLE_GT)
+DEFINE_SORTS(box_double_desc, void *, BOX_DOUBLE_LT)
+DEFINE_SORTS(box_char_asc, void *, BOX_CHAR_GT)
+DEFINE_SORTS(box_char_desc, void *, BOX_CHAR_LT)
+DEFINE_SORTS(box_str_asc, void *, BOX_STR_GT)
+DEFINE_SORTS(box_str_desc, void *, BOX_STR_LT)
+DEFINE_SELECT(int_asc, int, GT)
+DEFINE_SELECT(int_desc, int, LT)
+DEFINE_SELECT(double_asc, double, GT)
+DEFINE_SELECT(double_desc, double, LT)
+DEFINE_SELECT(char_asc, char, GT)
+DEFINE_SELECT(char_desc, char, LT)
+DEFINE_SELECT(str_asc, char *, STR_GT)
+DEFINE_SELECT(str_desc, char *, STR_LT)
+
+int typed_sort_supports(DataType type, int algo) {
+  if (algo == ALGO_RADIX)
+    return type != TYPE_CHAR;
+  if (algo == ALGO_SIMD)
+    return type == TYPE_INT;
+  if (algo == ALGO_BLOCK)
+    return type == TYPE_INT || type == TYPE_DOUBLE;
+  return 1;
+}
+
+void typed_sort(TypedArray *ta, int algo, int descending) {
+  if (algo == ALGO_PARALLEL) {
+    parallel_sort_typed(ta, descending, 0);
+    return;
+  }
+  if (algo == ALGO_RADIX) {
+    if (ta->type == TYPE_INT) {
+      radix_sort_int(ta->ints, ta->n, descending);
+      return;
+    }
+    if (ta->type == TYPE_DOUBLE) {
+      radix_sort_double(ta->doubles, ta->n, descending);
+      return;
+    }
+    if (ta->type == TYPE_STRING) {
+      string_sort(ta->strs, ta->n, descending); // MSD: multikey quicksort
+      return;
+    }
+    algo = ALGO_INTRO;
+  }
+  if (algo == ALGO_SIMD) {
+    if (ta->type == TYPE_INT) {
+      simd_sort_int(ta->ints, ta->n, descending);
+      return;
+    }
+    algo = ALGO_INTRO;
+  }
+  if (algo == ALGO_BLOCK) {
+    if (ta->type == TYPE_INT) {
+      block_sort_int(ta->ints, ta->n, descending);
+      return;
+    }
+    if (ta->type == TYPE_DOUBLE) {
+      block_sort_double(ta->doubles, ta->n, descending);
+      return;
+    }
+    algo = ALGO_INTRO;
+  }
+
+  switch (ta->type) {
+  case TYPE_INT:
+    if (descending)
+      sort_int_desc(ta->ints, ta->n, algo);
+    else
+      sort_int_asc(ta->ints, ta->n, algo);
+    break;
+  case TYPE_DOUBLE:
+    if (descending)
+      sort_double_desc(ta->doubles, ta->n, algo);
+    else
+      sort_double_asc(ta->doubles, ta->n, algo);
+    break;
+  case TYPE_CHAR:
+    if (descending)
+      sort_char_desc(ta->chars, ta->n, algo);
+    else
+      sort_char_asc(ta->chars, ta->n, algo);
+    break;
+  case TYPE_STRING:
+    if (descending)
+      sort_str_desc(ta->strs, ta->n, algo);
+    else
+      sort_str_asc(ta->strs, ta->n, algo);
+    break;
+  }
+}
+
+void typed_select(TypedArray *ta, int mode, int k, int descending) {
+  switch (ta->type) {
+  case TYPE_INT:
+    if (descending)
+      select_int_desc(ta->ints, ta->n, k, mode);
+    else
+      select_int_asc(ta->ints, ta->n, k, mode);
+    break;
+  case TYPE_DOUBLE:
+    if (descending)
+      select_double_desc(ta->doubles, ta->n, k, mode);
+    else
+      select_double_asc(ta->doubles, ta->n, k, mode);
+    break;
+  case TYPE_CHAR:
+    if (descending)
+      select_char_desc(ta->chars, ta->n, k, mode);
+    else
+      select_char_asc(ta->chars, ta->n, k, mode);
+    break;
+  case TYPE_STRING:
+    if (descending)
+      select_str_desc(ta->strs, ta->n, k, mode);
+    else
+      select_str_asc(ta->strs, ta->n, k, mode);
+    break;
+  }
+}
+
+void boxed_sort(void **arr, int n, DataType type, int algo, int descending) {
+  switch (type) {
+  case TYPE_INT:
+    if (descending)
+      sort_box_int_desc(arr, n, algo);
+    else
+      sort_box_int_asc(arr, n, algo);
+    break;
+  case TYPE_DOUBLE:
+    if (descending)
+      sort_box_double_desc(arr, n, algo);
+    else
+      sort_box_double_asc(arr, n, algo);
+    break;
+  case TYPE_CHAR:
+    if (descending)
+      sort_box_char_desc(arr, n, algo);
+    else
+      sort_box_char_asc(arr, n, algo);
+    break;
+  case TYPE_STRING:
+    if (descending)
+      sort_box_str_desc(arr, n, algo);
+    else
+      sort_box_str_asc(arr, n, algo);
+    break;
+  }
+}
+
+// --- Storage ---
+
+// Every buffer of the array comes from ta->arena, sized for one block
+void typed_array_alloc(TypedArray *ta, DataType type, int n, int str_len) {
+  memset(ta, 0, sizeof(*ta));
+  ta->type = type;
+  ta->n = n;
+  size_t elem = type == TYPE_INT      ? sizeof(int)
+                : type == TYPE_DOUBLE ? sizeof(double)
+                : type == TYPE_CHAR   ? 1
+                                      : sizeof(char *);
+  size_t pool = type == TYPE_STRING ? (size_t)n * (str_len + 1) : 0;
+  arena_init(&ta->arena, (size_t)n * elem + pool + 2 * sizeof(max_align_t));
+  if (n == 0)
+    return;
+
+  if (type == TYPE_INT)
+    ta->ints = arena_alloc(&ta->arena, n * sizeof(int));
+  else if (type == TYPE_DOUBLE)
+    ta->doubles = arena_alloc(&ta->arena, n * sizeof(double));
+  else if (type == TYPE_CHAR)
+    ta->chars = arena_alloc(&ta->arena, n);
+  else {
+    ta->strs = arena_alloc(&ta->arena, n * sizeof(char *));
+    ta->str_pool = arena_alloc(&ta->arena, pool);
+    for (int i = 0; i < n; i++) {
+      ta->strs[i] = ta->str_pool + (size_t)i * (str_len + 1);
+      ta->strs[i][str_len] = '\0';
+    }
+  }
+}
+
+void typed_array_free(TypedArray *ta) {
+  arena_free(&ta->arena);
+  memset(ta, 0, sizeof(*ta));
+}
+
+// Size of the string pool, found from the last string (pool is packed)
+static size_t str_pool_size(const TypedArray *ta) {
+  const char *end = ta->str_pool;
+  for (int i = 0; i < ta->n; i++) {
+    const char *e = ta->strs[i] + strlen(ta->strs[i]) + 1;
+    if (e > end)
+      end = e;
+  }
+  return end - ta->str_pool;
+}
+
+void typed_array_copy(TypedArray *dst, const TypedArray *src) {
+  *dst = *src;
+  size_t bytes = src->ints      ? src->n * sizeof(int)
+                 : src->doubles ? src->n * sizeof(double)
+                 : src->chars   ? (size_t)src->n
+                                : src->n * sizeof(char *);
+  size_t pool = src->strs ? str_pool_size(src) : 0;
+  arena_init(&dst->arena, bytes + pool + 2 * sizeof(max_align_t));
+  if (src->n == 0)
+    return;
+
+  if (src->ints)
+    dst->ints = memcpy(arena_alloc(&dst->arena, bytes), src->ints, bytes);
+  if (src->doubles)
+    dst->doubles = memcpy(arena_alloc(&dst->arena, bytes), src->doubles,
+                          bytes);
+  if (src->chars)
+    dst->chars = memcpy(arena_alloc(&dst->arena, bytes), src->chars, bytes);
+  if (src->strs) {
+    dst->str_pool =
+        memcpy(arena_alloc(&dst->arena, pool), src->str_pool, pool);
+    dst->strs = arena_alloc(&dst->arena, bytes);
+    for (int i = 0; i < src->n; i++)
+      dst->strs[i] = dst->str_pool + (src->strs[i] - src->str_pool);
+  }
+}
+
+// Boxes come from malloc, or from the arena when one is given
+static void *box_alloc(Arena *arena, size_t size) {
+  return arena ? arena_alloc(arena, size) : malloc(size);
+}
+
+void **typed_box(const TypedArray *ta, Arena *arena) {
+  void **boxed = box_alloc(arena, ta->n * sizeof(void *));
+  for (int i = 0; i < ta->n; i++) {
+    if (ta->type == TYPE_INT) {
+      int *v = box_alloc(arena, sizeof(int));
+      *v = ta->ints[i];
+      boxed[i] = v;
+    } else if (ta->type == TYPE_DOUBLE) {
+      double *v = box_alloc(arena, sizeof(double));
+      *v = ta->doubles[i];
+      boxed[i] = v;
+    } else if (ta->type == TYPE_CHAR) {
+      char *v = box_alloc(arena, sizeof(char));
+      *v = ta->chars[i];
+      boxed[i] = v;
+    } else {
+      size_t len = strlen(ta->strs[i]) + 1;
+      boxed[i] = memcpy(box_alloc(arena, len), ta->strs[i], len);
+    }
+  }
+  return boxed;
+}
+
+void typed_unbox(TypedArray *ta, void **boxed, Arena *arena) {
+  // The boxes hold copies, so the pool is rewritten in place in sorted order
+  // and stays packed
+  size_t used = 0;
+  for (int i = 0; i < ta->n; i++) {
+    if (ta->type == TYPE_INT)
+      ta->ints[i] = *(int *)boxed[i];
+    else if (ta->type == TYPE_DOUBLE)
+      ta->doubles[i] = *(double *)boxed[i];
+    else if (ta->type == TYPE_CHAR)
+      ta->chars[i] = *(char *)boxed[i];
+    else {
+      size_t len = strlen(boxed[i]) + 1;
+      memcpy(ta->str_pool + used, boxed[i], len);
+      ta->strs[i] = ta->str_pool + used;
+      used += len;
+    }
+  }
+
+  if (arena) {
+    arena_reset(arena);
+    return;
+  }
+  for (int i = 0; i < ta->n; i++)
+    free(boxed[i]);
+  free(boxed);
+}
@@ -0,0 +1,62 @@
+#ifndef TYPED_SORT_H
+#define TYPED_SORT_H
+
+// Contiguous typed storage for the sorting view and the sort kernels
+// specialised per element type. No GTK dependency.
+
+#include "arena.h"
+
+typedef enum { TYPE_INT, TYPE_DOUBLE, TYPE_CHAR, TYPE_STRING } DataType;
+
+typedef struct {
+  DataType type;
+  int n;
+  int *ints;      // TYPE_INT
+  double *doubles; // TYPE_DOUBLE
+  char *chars;    // TYPE_CHAR
+  char **strs;    // TYPE_STRING: pointers into str_pool
+  char *str_pool; // TYPE_STRING: every string back to back, NUL terminated
+  Arena arena;    // Owns every buffer above
+} TypedArray;
+
+// str_len is the length of each string (TYPE_STRING only). The buffers come
+// from a single arena block, so typed_array_free is one free whatever n is.
+void typed_array_alloc(TypedArray *ta, DataType type, int n, int str_len);
+void typed_array_free(TypedArray *ta);
+void typed_array_copy(TypedArray *dst, const TypedArray *src);
+
+// algo is a SortAlgo (sort.h). ALGO_RADIX is LSD for TYPE_INT and
+// TYPE_DOUBLE and a multikey quicksort for TYPE_STRING (string_sort.h);
+// ALGO_SIMD only exists for TYPE_INT and ALGO_BLOCK for TYPE_INT and
+// TYPE_DOUBLE. The other types fall back to ALGO_INTRO. ALGO_PARALLEL uses
+// parallel_get_threads() workers.
+void typed_sort(TypedArray *ta, int algo, int descending);
+int typed_sort_supports(DataType type, int algo);
+
+// Selection: only the k first values of the sort order (1 <= k <= n, k is
+// clamped to n). SELECT_NTH puts the k-th value at index k - 1 with the
+// values before it not after it in order (median: k = (n + 1) / 2);
+// SELECT_TOP_K and SELECT_PARTIAL leave [0, k) sorted. The rest of the
+// array is in no particular order.
+typedef enum {
+  SELECT_NTH,     // Introselect
+  SELECT_TOP_K,   // Max-heap of k elements, O(n log k)
+  SELECT_PARTIAL, // Partial quicksort
+  SELECT_COUNT
+} SelectMode;
+void typed_select(TypedArray *ta, int mode, int k, int descending);
+
+// Boxed baseline: one malloc per element, as the view used to store data.
+// With an arena the boxes are bumped out of it instead (same void* sorts,
+// without the malloc/free cost). typed_unbox copies the values back in boxed
+// order and releases the boxes: free() one by one, or arena_reset.
+void **typed_box(const TypedArray *ta, Arena *arena);
+void typed_unbox(TypedArray *ta, void **boxed, Arena *arena);
+
+// Sorts on boxed storage. type and direction are resolved once per call and
+// dispatch to a kernel with the comparison inlined (no comparator callback).
+// Sequential comparison sorts only (sort_is_comparison): ALGO_RADIX,
+// ALGO_PARALLEL, ALGO_SIMD and ALGO_BLOCK fall back to ALGO_INTRO.
+void boxed_sort(void **arr, int n, DataType type, int algo, int descending);
+
+#endif
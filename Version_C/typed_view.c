@@ -0,0 +1,99 @@
+#include "typed_view.h"
+#include <stdio.h>
+
+// --- Row Model ---
+// GListModel reporting ta->n items. Items are empty placeholders created on
+// demand for the rows the list view realises; the value is read from the
+// array by position when the row is bound.
+
+#define ROW_TYPE_MODEL (row_model_get_type())
+G_DECLARE_FINAL_TYPE(RowModel, row_model, ROW, MODEL, GObject)
+
+struct _RowModel {
+  GObject parent_instance;
+  const TypedArray *ta;
+  guint n;
+};
+
+static GType row_model_get_item_type(GListModel *list) {
+  return G_TYPE_OBJECT;
+}
+
+static guint row_model_get_n_items(GListModel *list) {
+  return ROW_MODEL(list)->n;
+}
+
+static gpointer row_model_get_item(GListModel *list, guint position) {
+  if (position >= ROW_MODEL(list)->n)
+    return NULL;
+  return g_object_new(G_TYPE_OBJECT, NULL);
+}
+
+static void row_model_list_init(GListModelInterface *iface) {
+  iface->get_item_type = row_model_get_item_type;
+  iface->get_n_items = row_model_get_n_items;
+  iface->get_item = row_model_get_item;
+}
+
+G_DEFINE_TYPE_WITH_CODE(RowModel, row_model, G_TYPE_OBJECT,
+                        G_IMPLEMENT_INTERFACE(G_TYPE_LIST_MODEL,
+                                              row_model_list_init))
+
+static void row_model_class_init(RowModelClass *klass) {}
+
+static void row_model_init(RowModel *self) {}
+
+// --- Row Factory ---
+
+static void on_row_setup(GtkSignalListItemFactory *factory,
+                         GtkListItem *item, gpointer data) {
+  GtkWidget *label = gtk_label_new(NULL);
+  gtk_label_set_xalign(GTK_LABEL(label), 0.0);
+  gtk_widget_add_css_class(label, "monospace");
+  gtk_list_item_set_child(item, label);
+}
+
+static void on_row_bind(GtkSignalListItemFactory *factory, GtkListItem *item,
+                        gpointer data) {
+  RowModel *model = data;
+  guint i = gtk_list_item_get_position(item);
+  const TypedArray *ta = model->ta;
+  char buf[96];
+
+  if (!ta || i >= model->n)
+    buf[0] = '\0';
+  else if (ta->type == TYPE_INT)
+    snprintf(buf, sizeof(buf), "%8u   %d", i, ta->ints[i]);
+  else if (ta->type == TYPE_DOUBLE)
+    snprintf(buf, sizeof(buf), "%8u   %g", i, ta->doubles[i]);
+  else if (ta->type == TYPE_CHAR)
+    snprintf(buf, sizeof(buf), "%8u   '%c'", i, ta->chars[i]);
+  else
+    snprintf(buf, sizeof(buf), "%8u   \"%.80s\"", i, ta->strs[i]);
+  gtk_label_set_text(GTK_LABEL(gtk_list_item_get_child(item)), buf);
+}
+
+// --- Public API ---
+
+GtkWidget *typed_view_new(void) {
+  RowModel *model = g_object_new(ROW_TYPE_MODEL, NULL);
+  GtkListItemFactory *factory = gtk_signal_list_item_factory_new();
+  g_signal_connect(factory, "setup", G_CALLBACK(on_row_setup), NULL);
+  g_signal_connect(factory, "bind", G_CALLBACK(on_row_bind), model);
+
+  // The selection model takes the model, the list view takes both
+  GtkSelectionModel *sel = GTK_SELECTION_MODEL(
+      gtk_no_selection_new(G_LIST_MODEL(model)));
+  GtkWidget *view = gtk_list_view_new(sel, factory);
+  g_object_set_data(G_OBJECT(view), "row-model", model);
+  return view;
+}
+
+void typed_view_set(GtkWidget *view, const TypedArray *ta) {
+  RowModel *model = g_object_get_data(G_OBJECT(view), "row-model");
+  guint old_n = model->n;
+  model->ta = ta;
+  model->n = ta ? ta->n : 0;
+  // Every row may have changed (sorted in place): rebind all of them
+  g_list_model_items_changed(G_LIST_MODEL(model), 0, old_n, model->n);
+}
@@ -0,0 +1,16 @@
+#ifndef TYPED_VIEW_H
+#define TYPED_VIEW_H
+
+#include "typed_sort.h"
+#include <gtk/gtk.h>
+
+// Virtualised GtkListView over a TypedArray: one row per element, formatted
+// only while visible, so millions of values can be scrolled instantly.
+
+GtkWidget *typed_view_new(void);
+
+// Shows ta (NULL: empty). The view keeps the pointer, not a copy: ta must
+// stay alive and be set again after it is freed or reallocated.
+void typed_view_set(GtkWidget *view, const TypedArray *ta);
+
+#endif